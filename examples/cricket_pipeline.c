@@ -65,11 +65,8 @@ int main(){
 
 		double *d_loss = mse_backward(arena, pred, targets, N_SAMPLES);
 
-		LayerGrad grad = dense_backward(arena, d_loss, features, weights, cache,
-		                                N_SAMPLES, N_FEATURES, 1, ACTIVATION_SIGMOID);
-
-		double *new_w = sgd_update(arena, weights, grad.d_weights, LR, N_FEATURES);
-		memcpy(weights, new_w, N_FEATURES * sizeof(double));
+		dense_backward_sgd(arena, d_loss, features, weights, cache,
+		                   N_SAMPLES, N_FEATURES, 1, ACTIVATION_SIGMOID, LR);
 		arena_clear(arena);
 
 	}
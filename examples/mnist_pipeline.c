@@ -98,17 +98,11 @@ int main(){
 
 		double *d_z2 = cross_entropy_backward(arena, pred, train_lbl, N_TRAIN, N_CLASSES);
 
-		LayerGrad grad2 = dense_backward(arena, d_z2, h, W2, NULL,
-		                                 N_TRAIN, N_HIDDEN, N_CLASSES, ACTIVATION_NONE);
+		double *d_h = dense_backward_sgd(arena, d_z2, h, W2, NULL,
+		                                 N_TRAIN, N_HIDDEN, N_CLASSES, ACTIVATION_NONE, LR);
 
-		LayerGrad grad1 = dense_backward(arena, grad2.d_input, train_img, W1, z1_cache,
-		                                 N_TRAIN, N_PIXELS, N_HIDDEN, ACTIVATION_RELU);
-
-		double *new_W1 = sgd_update(arena, W1, grad1.d_weights, LR, N_PIXELS * N_HIDDEN);
-		double *new_W2 = sgd_update(arena, W2, grad2.d_weights, LR, N_HIDDEN * N_CLASSES);
-
-		memcpy(W1, new_W1, N_PIXELS * N_HIDDEN * sizeof(double));
-		memcpy(W2, new_W2, N_HIDDEN * N_CLASSES * sizeof(double));
+		dense_backward_sgd(arena, d_h, train_img, W1, z1_cache,
+		                   N_TRAIN, N_PIXELS, N_HIDDEN, ACTIVATION_RELU, LR);
 		arena_clear(arena);
 
 	}
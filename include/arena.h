@@ -5,93 +5,522 @@
 #include <stdbool.h>
 #include <stdlib.h>
 
-//macros - I will set the alignment to the size of a void pointer instead of the user sepcifying
-#define ALIGNMENT sizeof(void*)
+//macros - default alignment for every push, 64 bytes so numeric buffers start on a cache line
+//and can be used with aligned SIMD loads. arena_push_aligned takes any other power of two.
+#ifndef ALIGNMENT
+#define ALIGNMENT 64
+#endif
+
+//growable arenas reserve address space per block and commit it in ARENA_COMMIT_SIZE steps
+#ifndef ARENA_RESERVE_SIZE
+#define ARENA_RESERVE_SIZE (64ull * 1024 * 1024 * 1024)
+#endif
+
+#ifndef ARENA_COMMIT_SIZE
+#define ARENA_COMMIT_SIZE (64ull * 1024)
+#endif
+
+//block size for chained growth when virtual memory is not available
+#ifndef ARENA_BLOCK_SIZE
+#define ARENA_BLOCK_SIZE (1024ull * 1024)
+#endif
+
+//huge page size used to align and commit ARENA_HUGE_PAGES / ARENA_HUGETLB arenas
+#ifndef ARENA_HUGE_PAGE_SIZE
+#define ARENA_HUGE_PAGE_SIZE (2ull * 1024 * 1024)
+#endif
+
+//ARENA_HAS_MMAN: munmap/mprotect are declared under any feature macros, so every TU can commit
+//and release a mapped block. ARENA_HAS_VIRTUAL: this TU can also create mappings, which needs
+//MAP_ANONYMOUS and so depends on the includer's feature macros (_POSIX_C_SOURCE hides it).
+//Blocks record how they were allocated (ARENA_VIRTUAL), so a block mapped in one TU is
+//unmapped in any other.
+#if !defined(__EMSCRIPTEN__) && (defined(__unix__) || defined(__APPLE__))
+#include <sys/mman.h>
+#define ARENA_HAS_MMAN 1
+#if !defined(ARENA_NO_VIRTUAL) && (defined(MAP_ANONYMOUS) || defined(MAP_ANON))
+#define ARENA_HAS_VIRTUAL 1
+#ifndef MAP_ANONYMOUS
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+#endif
+
+#define ARENA_GROWABLE   (1u << 0)
+#define ARENA_VIRTUAL    (1u << 1)
+#define ARENA_HUGE_PAGES (1u << 2)
+#define ARENA_HUGETLB    (1u << 3)
+#define ARENA_CONCURRENT (1u << 4)
+
+#if defined(__GNUC__) || defined(__clang__)
+#define ARENA_HAS_ATOMICS 1
+#endif
 
 typedef uint8_t u8;
 typedef uint16_t u16;
 typedef uint32_t u32;
 typedef uint64_t u64;
 
-typedef struct {
+typedef struct Arena Arena;
+
+struct Arena {
 
   u64 capacity;
   u64 position;
 
-} Arena;
+  //growable arenas only - position is global, current->base + current->position
+  u64 committed;
+  u64 base;
+  u32 flags;
+  Arena *current;
+  Arena *prev;
+
+  //malloc blocks - the unaligned pointer to free
+  void *raw;
+
+};
+
+//data starts after the header, rounded so the first push is ALIGNMENT aligned
+#define ARENA_HEADER_SIZE ((sizeof(Arena) + (ALIGNMENT - 1)) & ~(u64)(ALIGNMENT - 1))
+
+static inline u64 arena_align_up(u64 x, u64 align)
+{
+
+  return (x + (align - 1)) & ~(align - 1);
+
+}
+
+static inline void arena_init_block(Arena *block, u64 capacity, u64 committed, u64 base, u32 flags)
+{
+
+  block->capacity = capacity;
+  block->position = ARENA_HEADER_SIZE;
+  block->committed = committed;
+  block->base = base;
+  block->flags = flags;
+  block->current = block;
+  block->prev = NULL;
+  block->raw = NULL;
+
+}
+
+//malloc block with the header on an ALIGNMENT boundary
+static inline Arena *arena_malloc_block(u64 capacity, u64 base, u32 flags)
+{
+
+  void *raw = malloc(ARENA_HEADER_SIZE + capacity + ALIGNMENT - 1);
+  if (!raw) return NULL;
+
+  Arena *block = (Arena *)arena_align_up((u64)(uintptr_t)raw, ALIGNMENT);
+  arena_init_block(block, capacity, ARENA_HEADER_SIZE + capacity, base, flags & ~ARENA_VIRTUAL);
+  block->raw = raw;
+
+  return block;
+
+}
+
+#ifdef ARENA_HAS_VIRTUAL
+
+//reserve size bytes of address space, aligned to align (a multiple of the page size)
+static inline void *arena_map(u64 size, u64 align, int prot, int extra_flags)
+{
 
+  u64 padded = size + (align > 4096 ? align : 0);
+  u8 *mem = mmap(NULL, padded, prot, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+  if (mem == MAP_FAILED) return NULL;
+
+  if (padded == size) return mem;
+
+  //trim the unaligned head and the unused tail
+  u8 *aligned = (u8 *)(uintptr_t)arena_align_up((u64)(uintptr_t)mem, align);
+  if (aligned > mem) munmap(mem, aligned - mem);
+  if (mem + padded > aligned + size) munmap(aligned + size, (mem + padded) - (aligned + size));
+
+  return aligned;
+
+}
+
+static inline void arena_advise_huge(void *mem, u64 size)
+{
+
+#ifdef MADV_HUGEPAGE
+  madvise(mem, size, MADV_HUGEPAGE);
+#else
+  (void)mem;
+  (void)size;
+#endif
+
+}
+
+#endif
 
 static inline Arena *arena_create(u64 capacity)
 
 {
 
-  Arena *arena = malloc(sizeof(*arena) + capacity);
-  arena->capacity = capacity;
-  arena->position = sizeof(*arena);
+  return arena_malloc_block(capacity, 0, 0);
 
-  return arena;
+}
+
+//fixed arena on huge pages - explicit hugetlbfs pages first for ARENA_HUGETLB, then transparent ones
+static inline Arena *arena_create_huge(u64 capacity, u32 flags)
+{
+
+#ifdef ARENA_HAS_VIRTUAL
+
+  u64 size = arena_align_up(ARENA_HEADER_SIZE + capacity, ARENA_HUGE_PAGE_SIZE);
+  void *mem = NULL;
+
+#ifdef MAP_HUGETLB
+  if (flags & ARENA_HUGETLB)
+    mem = arena_map(size, 4096, PROT_READ | PROT_WRITE, MAP_HUGETLB);
+#endif
+
+  if (!mem){
+
+    flags &= ~ARENA_HUGETLB;
+    mem = arena_map(size, ARENA_HUGE_PAGE_SIZE, PROT_READ | PROT_WRITE, 0);
+    if (mem) arena_advise_huge(mem, size);
+
+  }
+
+  if (mem){
+
+    Arena *arena = mem;
+    arena_init_block(arena, size - ARENA_HEADER_SIZE, size, 0, flags | ARENA_VIRTUAL);
+    return arena;
+
+  }
+
+#endif
+
+  return arena_malloc_block(capacity, 0, flags & ~(ARENA_HUGE_PAGES | ARENA_HUGETLB));
 
 }
 
-static inline void *arena_push(Arena *arena, u64 size)
+static inline u64 arena_commit_step(Arena *block)
+{
+
+  return (block->flags & ARENA_HUGE_PAGES) ? ARENA_HUGE_PAGE_SIZE : ARENA_COMMIT_SIZE;
 
+}
+
+//new growable block holding at least need bytes - a virtual reservation of capacity
+//bytes when possible, otherwise a malloc block of up to ARENA_BLOCK_SIZE
+static inline Arena *arena_create_block(u64 capacity, u64 need, u64 base, u32 flags)
 {
 
-  u64 aligned_size = (size + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1);
+  if (capacity < need) capacity = need;
 
-  if (arena->position + aligned_size > sizeof(*arena) + arena->capacity)
-  {
+#ifdef ARENA_HAS_VIRTUAL
+
+  u64 align = (flags & ARENA_HUGE_PAGES) ? ARENA_HUGE_PAGE_SIZE : 4096;
+  u64 step = (flags & ARENA_HUGE_PAGES) ? ARENA_HUGE_PAGE_SIZE : ARENA_COMMIT_SIZE;
+  u64 reserve = arena_align_up(ARENA_HEADER_SIZE + capacity, step);
+  void *mem = arena_map(reserve, align, PROT_NONE, 0);
+
+  if (mem){
+
+    u64 commit = step < reserve ? step : reserve;
+
+    if (flags & ARENA_HUGE_PAGES) arena_advise_huge(mem, reserve);
+
+    if (mprotect(mem, commit, PROT_READ | PROT_WRITE) == 0){
+
+      Arena *block = mem;
+      arena_init_block(block, reserve - ARENA_HEADER_SIZE, commit, base, flags | ARENA_VIRTUAL);
+      return block;
+
+    }
+
+    munmap(mem, reserve);
+
+  }
+
+#endif
+
+  if (capacity > ARENA_BLOCK_SIZE) capacity = ARENA_BLOCK_SIZE;
+  if (capacity < need) capacity = need;
+
+  return arena_malloc_block(capacity, base, flags & ~(ARENA_HUGE_PAGES | ARENA_HUGETLB));
+
+}
+
+static inline void arena_free_block(Arena *block)
+{
+
+#ifdef ARENA_HAS_MMAN
+  if (block->flags & ARENA_VIRTUAL){
+
+    munmap(block, ARENA_HEADER_SIZE + block->capacity);
+    return;
+
+  }
+#endif
+
+  free(block->raw);
+
+}
+
+//flags: 0 for a fixed arena, ARENA_GROWABLE to grow on demand (capacity is then the per-block
+//reservation), ARENA_HUGE_PAGES / ARENA_HUGETLB to back the arena with huge pages,
+//ARENA_CONCURRENT for a fixed arena that many threads can push to at once
+static inline Arena *arena_create_ex(u64 capacity, u32 flags)
+{
+
+  if (flags & ARENA_CONCURRENT){
 
+#ifndef ARENA_HAS_ATOMICS
     return NULL;
+#endif
+
+    //growing is not lock-free, concurrent arenas are always fixed
+    flags &= ~ARENA_GROWABLE;
+
   }
 
-void *result = (u8*)arena + arena->position;
-  arena->position += aligned_size;
+  if (!(flags & ARENA_GROWABLE)){
 
-  return result;
+    Arena *arena;
+
+    if (flags & (ARENA_HUGE_PAGES | ARENA_HUGETLB))
+      arena = arena_create_huge(capacity, flags | ARENA_HUGE_PAGES);
+    else
+      arena = arena_create(capacity);
+
+    if (arena) arena->flags |= flags & ARENA_CONCURRENT;
+
+    return arena;
 
   }
 
-static inline void arena_pop(Arena *arena, u64 size)
+  //explicit huge pages cannot be committed lazily, growable arenas use transparent ones
+  if (flags & ARENA_HUGETLB) flags = (flags & ~ARENA_HUGETLB) | ARENA_HUGE_PAGES;
+
+  if (capacity == 0) capacity = ARENA_RESERVE_SIZE;
+
+  return arena_create_block(capacity, 0, 0, flags);
+
+}
+
+static inline u64 arena_pos(Arena *arena)
 {
 
-  u64 aligned_size = (size + (ALIGNMENT - 1)) & ~(ALIGNMENT - 1);
-  arena->position -= aligned_size;
-  if (arena->position < sizeof(*arena)){
-  
-    arena->position = sizeof(*arena);
-    
+  Arena *current = arena->current;
+  return current->base + current->position;
+
 }
 
+//make sure [0, end) of a virtual block is readable/writable
+static inline bool arena_commit(Arena *block, u64 end)
+{
+
+#ifdef ARENA_HAS_MMAN
+  if ((block->flags & ARENA_VIRTUAL) && end > block->committed){
+
+    u64 commit = arena_align_up(end, arena_commit_step(block));
+    u64 total = ARENA_HEADER_SIZE + block->capacity;
+    if (commit > total) commit = total;
+
+    if (mprotect((u8*)block + block->committed, commit - block->committed, PROT_READ | PROT_WRITE) != 0)
+      return false;
+
+    block->committed = commit;
+
+  }
+#endif
+
+  return end <= block->committed;
+
+}
+
+//lock-free bump for ARENA_CONCURRENT arenas: claim [start, end) with a CAS loop on the
+//position. A push that does not fit returns NULL without moving the position, so a failed
+//oversized request never takes space from smaller pushes that still fit.
+static inline void *arena_push_concurrent(Arena *arena, u64 size, u64 align)
+{
+
+#ifdef ARENA_HAS_ATOMICS
+
+  if (align < ALIGNMENT) align = ALIGNMENT;
+
+  u64 aligned_size = arena_align_up(size, align);
+  u64 limit = ARENA_HEADER_SIZE + arena->capacity;
+  u64 position = __atomic_load_n(&arena->position, __ATOMIC_RELAXED);
+
+  for (;;){
+
+    //sizes are rounded to at least ALIGNMENT, so with default alignment start == position
+    u64 start = arena_align_up((u64)(uintptr_t)arena + position, align) - (u64)(uintptr_t)arena;
+    u64 end = start + aligned_size;
+
+    if (end > limit)
+      return NULL;
+
+    if (__atomic_compare_exchange_n(&arena->position, &position, end, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+      return (u8*)arena + start;
+
+  }
+
+#else
+
+  (void)arena;
+  (void)size;
+  (void)align;
+  return NULL;
+
+#endif
+
+}
+
+//align must be a power of two; the returned address (not just the offset) is aligned
+static inline void *arena_push_aligned(Arena *arena, u64 size, u64 align)
+
+{
+
+  if (arena->flags & ARENA_CONCURRENT)
+    return arena_push_concurrent(arena, size, align);
+
+  u64 aligned_size = arena_align_up(size, align);
+  Arena *current = arena->current;
+
+  u64 start = arena_align_up((u64)(uintptr_t)current + current->position, align) - (u64)(uintptr_t)current;
+
+  if (start + aligned_size > ARENA_HEADER_SIZE + current->capacity ||
+      !arena_commit(current, start + aligned_size))
+  {
+
+    if (!(arena->flags & ARENA_GROWABLE))
+      return NULL;
+
+    //chain a new block; earlier pointers stay where they are
+    Arena *block = arena_create_block(arena->capacity, aligned_size + align, arena_pos(arena) - ARENA_HEADER_SIZE, arena->flags);
+
+    if (!block) return NULL;
+
+    block->prev = current;
+    arena->current = block;
+    current = block;
+
+    start = arena_align_up((u64)(uintptr_t)current + current->position, align) - (u64)(uintptr_t)current;
+
+    if (!arena_commit(current, start + aligned_size))
+      return NULL;
+
+  }
+
+void *result = (u8*)current + start;
+  current->position = start + aligned_size;
+
+  return result;
+
+  }
+
+static inline void *arena_push(Arena *arena, u64 size)
+{
+
+  return arena_push_aligned(arena, size, ALIGNMENT);
 
 }
 
 static inline void arena_pop_to(Arena *arena, u64 position)
 {
 
-  if (position < sizeof(*arena)) {
+  //drop whole blocks that start above the target
+  while (arena->current != arena && position < arena->current->base + ARENA_HEADER_SIZE){
 
-    position = sizeof(*arena);
+    Arena *prev = arena->current->prev;
+    arena_free_block(arena->current);
+    arena->current = prev;
+
+  }
+
+  Arena *current = arena->current;
+  u64 local = position > current->base ? position - current->base : 0;
+
+  if (local < ARENA_HEADER_SIZE) {
+
+    local = ARENA_HEADER_SIZE;
 
 }
-  if (position > arena->position){
+  if (local > current->position){
 
-    position = arena->position;
+    local = current->position;
 
 }
 
-  arena->position = position;
+  current->position = local;
+
+}
+
+static inline void arena_pop(Arena *arena, u64 size)
+{
+
+  u64 aligned_size = arena_align_up(size, ALIGNMENT);
+  u64 position = arena_pos(arena);
+
+  arena_pop_to(arena, position > aligned_size ? position - aligned_size : 0);
 
 }
 
 static inline void arena_clear(Arena *arena)
 {
-  arena->position = sizeof(*arena);
+  arena_pop_to(arena, 0);
 }
 
 static inline void arena_destroy(Arena *arena){
 
-  free(arena);
+  if (!arena) return;
+
+  Arena *block = arena->current;
+  while (block){
+
+    Arena *prev = block->prev;
+    arena_free_block(block);
+    block = prev;
+
+  }
+}
+
+//temp scopes - remember the position on begin and pop back to it on end
+typedef struct {
+
+  Arena *arena;
+  u64 position;
+
+} ArenaTemp;
+
+static inline ArenaTemp arena_temp_begin(Arena *arena)
+{
+
+  ArenaTemp temp;
+  temp.arena = arena;
+  temp.position = arena_pos(arena);
+
+  return temp;
+
+}
+
+static inline void arena_temp_end(ArenaTemp temp)
+{
+
+  arena_pop_to(temp.arena, temp.position);
+
+}
+
+//scratch arenas - per thread, for kernel temporaries that must not land on the caller's arena
+#ifndef ARENA_SCRATCH_CAPACITY
+#define ARENA_SCRATCH_CAPACITY (64ull * 1024 * 1024)
+#endif
+
+ArenaTemp arena_scratch_begin(Arena **conflicts, int n_conflicts);
+void arena_scratch_release(void);
+
+static inline void arena_scratch_end(ArenaTemp temp)
+{
+
+  if (temp.arena) arena_temp_end(temp);
+
 }
 
 #endif
@@ -0,0 +1,80 @@
+#ifndef TAPE_H
+#define TAPE_H
+
+#include "../arena.h"
+
+typedef enum {
+	TAPE_INPUT,
+	TAPE_PARAM,
+	TAPE_MATMUL,
+	TAPE_ADD,
+	TAPE_SUB,
+	TAPE_MUL,
+	TAPE_SCALE,
+	TAPE_RELU,
+	TAPE_SIGMOID,
+	TAPE_TANH,
+	TAPE_SOFTMAX,
+	TAPE_MSE,
+	TAPE_CROSS_ENTROPY,
+	TAPE_SOFTMAX_CROSS_ENTROPY
+} TapeOp;
+
+typedef struct {
+	TapeOp op;
+	int a;
+	int b;
+	int rows;
+	int cols;
+	double scalar;
+	double *value;
+	double *grad;
+	u64 value_bytes;
+	u64 grad_bytes;
+	int requires_grad;
+} TapeNode;
+
+typedef struct TapeFreeBlock {
+	struct TapeFreeBlock *next;
+	u64 size;
+} TapeFreeBlock;
+
+typedef struct {
+	Arena *arena;
+	TapeNode *nodes;
+	int n_nodes;
+	int capacity;
+	u64 mark;
+	TapeFreeBlock *free_list;
+	u64 bytes_in_use;
+	u64 peak_bytes;
+} Tape;
+
+Tape *tape_create(Arena *arena);
+void tape_reset(Tape *tape);
+void tape_destroy(Tape *tape);
+
+double *tape_alloc(Tape *tape, u64 bytes, u64 *size_out);
+void tape_free(Tape *tape, double *ptr, u64 size);
+
+int tape_input(Tape *tape, double *data, int rows, int cols);
+int tape_param(Tape *tape, double *data, int rows, int cols);
+int tape_matmul(Tape *tape, int a, int b);
+int tape_add(Tape *tape, int a, int b);
+int tape_sub(Tape *tape, int a, int b);
+int tape_mul(Tape *tape, int a, int b);
+int tape_scale(Tape *tape, int a, double s);
+int tape_relu(Tape *tape, int a);
+int tape_sigmoid(Tape *tape, int a);
+int tape_tanh(Tape *tape, int a);
+int tape_softmax(Tape *tape, int a);
+int tape_mse(Tape *tape, int pred, int target);
+int tape_cross_entropy(Tape *tape, int pred, int target);
+int tape_softmax_cross_entropy(Tape *tape, int logits, int target);
+
+double *tape_value(Tape *tape, int id);
+double *tape_grad(Tape *tape, int id);
+
+int tape_backward(Tape *tape, int loss);
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef TAPE_PLAN_H
+#define TAPE_PLAN_H
+
+#include "../arena.h"
+#include "tape.h"
+
+#define TAPE_PLAN_TILE 1024
+
+typedef struct {
+	int head;
+	int out;
+	int anchored;
+	int *ops;
+	int n_ops;
+	int tile_rows;
+} FusedGroup;
+
+typedef struct {
+	TapeNode *nodes;
+	int n_nodes;
+	int loss;
+	FusedGroup *groups;
+	int n_groups;
+	u8 *fused_update;
+	double *tile;
+	double *tile_grad;
+	double lr;
+	Arena *arena;
+} TapePlan;
+
+TapePlan *tape_plan_compile(Tape *tape, int loss, double lr);
+double tape_plan_run(TapePlan *plan);
+double *tape_plan_value(TapePlan *plan, int id);
+void tape_plan_destroy(TapePlan *plan);
+
+#endif
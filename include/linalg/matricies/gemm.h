@@ -0,0 +1,6 @@
+#ifndef GEMM_H
+#define GEMM_H
+
+void gemm(double *c, double *a, double *b, int m, int n, int p, int trans_a, int trans_b, double alpha, double beta);
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef GEMM_F32_H
+#define GEMM_F32_H
+
+void gemm_f32(float *c, float *a, float *b, int m, int n, int p, int trans_a, int trans_b, float alpha, float beta);
+
+#endif
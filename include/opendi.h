@@ -71,6 +71,8 @@ extern "C" {
 #include "linalg/matricies/matmul.h"
 #include "linalg/matricies/matscale.h"
 #include "linalg/matricies/mattranspose.h"
+#include "linalg/matricies/gemm.h"
+#include "linalg/matricies/gemm_f32.h"
 
 /*
  * Loss Functions
@@ -94,11 +96,21 @@ extern "C" {
 #include "backward/linalg/matmul_backward_a.h"
 #include "backward/linalg/matmul_backward_b.h"
 
+/*
+ * Autodiff
+ * Reverse-mode differentiation over a recorded tape of ops
+ */
+#include "autodiff/tape.h"
+#include "autodiff/tape_plan.h"
+
 /*
  * Optimizers
  * Weight update algorithms for training
  */
 #include "optimizers/sgd_update.h"
+#include "optimizers/momentum.h"
+#include "optimizers/adam.h"
+#include "optimizers/rmsprop.h"
 
 /*
  * Random
@@ -107,12 +119,16 @@ extern "C" {
 #include "random/random_seed.h"
 #include "random/random_uniform.h"
 #include "random/random_normal.h"
+#include "random/philox.h"
+#include "random/rng.h"
+#include "random/ziggurat.h"
 
 /*
  * Statistics
  * Statistical functions for data preprocessing
  */
 #include "statistics/normalize.h"
+#include "statistics/column_stats.h"
 
 /*
  * Pipeline
@@ -123,12 +139,35 @@ extern "C" {
 #include "pipeline/batch_sigmoid.h"
 #include "pipeline/batch_softmax.h"
 #include "pipeline/batch_normalize.h"
+#include "pipeline/batch_norm.h"
+#include "pipeline/layer_norm.h"
 #include "pipeline/mse_backward.h"
 #include "pipeline/cross_entropy_backward.h"
 #include "pipeline/accuracy.h"
 #include "pipeline/init_weights.h"
 #include "pipeline/dense_forward.h"
 #include "pipeline/dense_backward.h"
+#include "pipeline/dense_backward_sgd.h"
+#include "pipeline/dense_backward_accumulate.h"
+#include "pipeline/im2col.h"
+#include "pipeline/conv2d.h"
+#include "pipeline/pool2d.h"
+#include "pipeline/dropout.h"
+#include "pipeline/embedding.h"
+#include "pipeline/recurrent.h"
+#include "pipeline/attention.h"
+
+/*
+ * Training
+ * Mini-batch iteration and training loops
+ */
+#include "training/minibatch.h"
+#include "training/memory_plan.h"
+#include "training/activation_inplace.h"
+#include "training/trainer.h"
+#include "training/parallel_trainer.h"
+#include "training/hogwild_trainer.h"
+#include "training/mixed_trainer.h"
 
 #ifdef __cplusplus
 }
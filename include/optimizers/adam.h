@@ -0,0 +1,24 @@
+#ifndef ADAM_H
+#define ADAM_H
+
+#include "../pipeline/pipeline_types.h"
+
+typedef struct {
+	double *m;
+	double *v;
+	int n;
+	int t;
+	double beta1;
+	double beta2;
+	double eps;
+	double weight_decay;
+	int decoupled;
+} AdamState;
+
+AdamState *adam_create(int n, double beta1, double beta2, double eps, double weight_decay);
+AdamState *adamw_create(int n, double beta1, double beta2, double eps, double weight_decay);
+void adam_update(AdamState *state, double *weights, double *grads, double lr);
+void adam_update_sparse(AdamState *state, double *table, SparseGrad *grad, double lr);
+void adam_destroy(AdamState *state);
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef MOMENTUM_H
+#define MOMENTUM_H
+
+#include "../pipeline/pipeline_types.h"
+
+typedef struct {
+	double *velocity;
+	int n;
+	double momentum;
+	double weight_decay;
+	int nesterov;
+} MomentumState;
+
+MomentumState *momentum_create(int n, double momentum, double weight_decay, int nesterov);
+void momentum_update(MomentumState *state, double *weights, double *grads, double lr);
+void momentum_update_sparse(MomentumState *state, double *table, SparseGrad *grad, double lr);
+void momentum_destroy(MomentumState *state);
+
+#endif
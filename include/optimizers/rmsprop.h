@@ -0,0 +1,19 @@
+#ifndef RMSPROP_H
+#define RMSPROP_H
+
+#include "../pipeline/pipeline_types.h"
+
+typedef struct {
+	double *sq_avg;
+	int n;
+	double decay;
+	double eps;
+	double weight_decay;
+} RMSPropState;
+
+RMSPropState *rmsprop_create(int n, double decay, double eps, double weight_decay);
+void rmsprop_update(RMSPropState *state, double *weights, double *grads, double lr);
+void rmsprop_update_sparse(RMSPropState *state, double *table, SparseGrad *grad, double lr);
+void rmsprop_destroy(RMSPropState *state);
+
+#endif
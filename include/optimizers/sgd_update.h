@@ -2,7 +2,9 @@
 #define SGD_UPDATE_H
 
 #include "../arena.h"
+#include "../pipeline/pipeline_types.h"
 
 double *sgd_update(Arena *arena, double *weights, double *grads, double lr, int n);
+void sgd_update_sparse(double *table, SparseGrad *grad, double lr);
 
 #endif
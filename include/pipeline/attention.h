@@ -0,0 +1,17 @@
+#ifndef ATTENTION_H
+#define ATTENTION_H
+
+#include "../arena.h"
+
+#define ATTENTION_TILE 64
+
+typedef struct {
+	double *d_q;
+	double *d_k;
+	double *d_v;
+} AttentionGrad;
+
+double *attention_forward(Arena *arena, double *q, double *k, double *v, int seq_q, int seq_k, int d, int dv, double **lse);
+AttentionGrad attention_backward(Arena *arena, double *dout, double *q, double *k, double *v, double *out, double *lse, int seq_q, int seq_k, int d, int dv);
+
+#endif
@@ -0,0 +1,28 @@
+#ifndef BATCH_NORM_H
+#define BATCH_NORM_H
+
+#include "../arena.h"
+
+#define BATCH_NORM_MOMENTUM 0.1
+#define BATCH_NORM_EPS 1e-5
+
+typedef struct {
+	double *gamma;
+	double *beta;
+	double *running_mean;
+	double *running_var;
+	int n_features;
+	double momentum;
+	double eps;
+} BatchNormLayer;
+
+typedef struct {
+	double *x_hat;
+	double *inv_std;
+} BatchNormCache;
+
+void batch_norm_init(BatchNormLayer *bn, double *params, int n_features);
+double *batch_norm_forward(Arena *arena, BatchNormLayer *bn, double *input, int m, int training, BatchNormCache *cache);
+double *batch_norm_backward(Arena *arena, BatchNormLayer *bn, double *dout, BatchNormCache *cache, int m, double *d_gamma, double *d_beta);
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef CONV2D_H
+#define CONV2D_H
+
+#include "../arena.h"
+#include "pipeline_types.h"
+
+typedef struct {
+	double *d_weights;
+	double *d_bias;
+	double *d_input;
+} ConvGrad;
+
+double *conv2d_forward(Arena *arena, double *input, double *weights, double *bias, int m, Window2d *shape, int filters);
+ConvGrad conv2d_backward(Arena *arena, double *dout, double *input, double *weights, int m, Window2d *shape, int filters);
+
+#endif
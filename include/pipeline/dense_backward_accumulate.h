@@ -0,0 +1,9 @@
+#ifndef DENSE_BACKWARD_ACCUMULATE_H
+#define DENSE_BACKWARD_ACCUMULATE_H
+
+#include "../arena.h"
+#include "pipeline_types.h"
+
+double *dense_backward_accumulate(Arena *arena, double *dout, double *input, double *weights, double *cache, double *d_weights, int m, int n, int p, ActivationType act);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef DENSE_BACKWARD_SGD_H
+#define DENSE_BACKWARD_SGD_H
+
+#include "../arena.h"
+#include "pipeline_types.h"
+
+#define DENSE_SGD_TILE 32
+
+double *dense_backward_sgd(Arena *arena, double *dout, double *input, double *weights, double *cache, int m, int n, int p, ActivationType act, double lr);
+
+#endif
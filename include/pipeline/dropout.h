@@ -0,0 +1,12 @@
+#ifndef DROPOUT_H
+#define DROPOUT_H
+
+#include "../arena.h"
+
+#define DROPOUT_MASK_WORDS(n) (((u64)(n) + 63) / 64)
+
+void dropout_mask(u64 *mask, int n, double rate, u64 seed, u64 step);
+double *dropout_forward(Arena *arena, double *input, int n, double rate, u64 seed, u64 step, u64 **mask);
+double *dropout_backward(Arena *arena, double *dout, u64 *mask, int n, double rate);
+
+#endif
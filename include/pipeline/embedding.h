@@ -0,0 +1,10 @@
+#ifndef EMBEDDING_H
+#define EMBEDDING_H
+
+#include "../arena.h"
+#include "pipeline_types.h"
+
+double *embedding_forward(Arena *arena, double *table, int *ids, int n_ids, int dim);
+SparseGrad embedding_backward(Arena *arena, double *dout, int *ids, int n_ids, int dim);
+
+#endif
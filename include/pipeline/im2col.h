@@ -0,0 +1,10 @@
+#ifndef IM2COL_H
+#define IM2COL_H
+
+#include "pipeline_types.h"
+
+int window_out(int size, int kernel, int stride, int padding);
+void im2col(double *cols, double *image, Window2d *w);
+void col2im(double *image, double *cols, Window2d *w);
+
+#endif
@@ -1,6 +1,11 @@
 #ifndef INIT_WEIGHTS_H
 #define INIT_WEIGHTS_H
 
+#include "../random/rng.h"
+
+typedef enum { INIT_XAVIER_UNIFORM, INIT_XAVIER_NORMAL, INIT_HE_UNIFORM, INIT_HE_NORMAL } InitScheme;
+
 double *init_weights(int n, double mean, double std);
+void init_fill(Rng *rng, double *weights, int fan_in, int fan_out, InitScheme scheme);
 
 #endif
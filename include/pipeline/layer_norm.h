@@ -0,0 +1,20 @@
+#ifndef LAYER_NORM_H
+#define LAYER_NORM_H
+
+#include "../arena.h"
+
+#define LAYER_NORM_EPS 1e-5
+#define NORM_PARALLEL_MIN 65536
+#define NORM_MAX_THREADS 8
+
+typedef struct {
+	double *mean;
+	double *rstd;
+} NormCache;
+
+double *layer_norm_forward(Arena *arena, double *input, double *gamma, double *beta, int m, int n, double eps, NormCache *cache);
+double *layer_norm_backward(Arena *arena, double *dout, double *input, double *gamma, NormCache *cache, int m, int n, double *d_gamma, double *d_beta);
+double *rms_norm_forward(Arena *arena, double *input, double *gamma, int m, int n, double eps, NormCache *cache);
+double *rms_norm_backward(Arena *arena, double *dout, double *input, double *gamma, NormCache *cache, int m, int n, double *d_gamma);
+
+#endif
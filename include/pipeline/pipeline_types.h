@@ -3,9 +3,34 @@
 
 typedef enum { ACTIVATION_NONE, ACTIVATION_RELU, ACTIVATION_SIGMOID, ACTIVATION_SOFTMAX } ActivationType;
 
+typedef enum { LOSS_MSE, LOSS_CROSS_ENTROPY } LossType;
+
 typedef struct {
 	double *d_weights;
 	double *d_input;
 } LayerGrad;
 
+typedef struct {
+	int *rows;
+	double *values;
+	int n_rows;
+	int dim;
+} SparseGrad;
+
+typedef struct {
+	double *weights;
+	int n_in;
+	int n_out;
+	ActivationType act;
+} DenseLayer;
+
+typedef struct {
+	int channels;
+	int height;
+	int width;
+	int kernel;
+	int stride;
+	int padding;
+} Window2d;
+
 #endif
@@ -0,0 +1,12 @@
+#ifndef POOL2D_H
+#define POOL2D_H
+
+#include "../arena.h"
+#include "pipeline_types.h"
+
+double *max_pool2d_forward(Arena *arena, double *input, int m, Window2d *shape, int **argmax);
+double *max_pool2d_backward(Arena *arena, double *dout, int *argmax, int m, Window2d *shape);
+double *avg_pool2d_forward(Arena *arena, double *input, int m, Window2d *shape);
+double *avg_pool2d_backward(Arena *arena, double *dout, int m, Window2d *shape);
+
+#endif
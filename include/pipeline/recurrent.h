@@ -0,0 +1,37 @@
+#ifndef RECURRENT_H
+#define RECURRENT_H
+
+#include "../arena.h"
+
+typedef enum { CELL_GRU, CELL_LSTM } CellType;
+
+// gate blocks per cell: GRU packs [z r n], LSTM packs [i f g o]
+#define RECURRENT_GATES(cell) ((cell) == CELL_LSTM ? 4 : 3)
+#define RECURRENT_PARAMS(cell, n_in, hidden) ((size_t)((n_in) + (hidden) + 1) * RECURRENT_GATES(cell) * (hidden))
+
+typedef struct {
+	CellType cell;
+	int n_in;
+	int hidden;
+	double *w_x;
+	double *w_h;
+	double *bias;
+} RecurrentLayer;
+
+typedef struct {
+	double *gates;
+	double *state;
+} RecurrentCache;
+
+typedef struct {
+	double *d_w_x;
+	double *d_w_h;
+	double *d_bias;
+	double *d_input;
+} RecurrentGrad;
+
+void recurrent_init(RecurrentLayer *rnn, CellType cell, double *params, int n_in, int hidden);
+double *recurrent_forward(Arena *arena, RecurrentLayer *rnn, double *input, int steps, int m, RecurrentCache *cache);
+RecurrentGrad recurrent_backward(Arena *arena, RecurrentLayer *rnn, double *dout, double *input, double *output, RecurrentCache *cache, int steps, int m);
+
+#endif
@@ -0,0 +1,11 @@
+#ifndef PHILOX_H
+#define PHILOX_H
+
+#include "../arena.h"
+
+#define PHILOX_ROUNDS 10
+
+void philox4x32(u32 out[4], const u32 counter[4], const u32 key[2]);
+void philox_fill(u32 *out, u64 n, u64 seed, u64 stream, u64 first_block);
+
+#endif
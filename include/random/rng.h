@@ -0,0 +1,43 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stddef.h>
+#include <string.h>
+#include "../arena.h"
+
+#define RNG_CHUNK 256
+
+typedef enum { RNG_XOSHIRO, RNG_PHILOX } RngKind;
+
+// xoshiro256** keeps its 256-bit state in s; Philox keeps {seed, stream,
+// next block} in s and the unread words of the current block in block
+typedef struct {
+	RngKind kind;
+	u64 s[4];
+	u32 block[4];
+	int used;
+} Rng;
+
+// the top 52 bits become the mantissa of a double in [1, 2): an integer
+// OR and a subtraction, which vectorizes where a u64 to double cast does not
+static inline double rng_unit(u64 bits){
+
+	double d;
+	u64 x = (bits >> 12) | 0x3FF0000000000000ull;
+	memcpy(&d, &x, sizeof(d));
+
+	return d - 1.0;
+
+}
+
+void rng_seed(Rng *rng, RngKind kind, u64 seed);
+void rng_jump(Rng *rng);
+u64 rng_next(Rng *rng);
+void rng_fill_bits(Rng *rng, u64 *bits, size_t n);
+u64 rng_below(Rng *rng, u64 bound);
+double rng_uniform(Rng *rng);
+void rng_fill_uniform(Rng *rng, double *out, size_t n, double min, double max);
+void rng_fill_uniform_f(Rng *rng, float *out, size_t n, float min, float max);
+Rng *rng_default(void);
+
+#endif
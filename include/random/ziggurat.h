@@ -0,0 +1,15 @@
+#ifndef ZIGGURAT_H
+#define ZIGGURAT_H
+
+#include "rng.h"
+
+#define ZIGGURAT_LAYERS 256
+#define ZIGGURAT_R 3.6541528853610088
+#define ZIGGURAT_V 4.92867323399e-3
+
+double rng_normal(Rng *rng);
+void rng_fill_normal(Rng *rng, double *out, size_t n, double mean, double std);
+void rng_fill_normal_f(Rng *rng, float *out, size_t n, float mean, float std);
+void rng_fill_truncated_normal(Rng *rng, double *out, size_t n, double mean, double std, double lo, double hi);
+
+#endif
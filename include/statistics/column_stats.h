@@ -0,0 +1,6 @@
+#ifndef COLUMN_STATS_H
+#define COLUMN_STATS_H
+
+void column_moments(double *x, int rows, int cols, double *mean, double *var);
+
+#endif
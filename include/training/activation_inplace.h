@@ -0,0 +1,9 @@
+#ifndef ACTIVATION_INPLACE_H
+#define ACTIVATION_INPLACE_H
+
+#include "../pipeline/pipeline_types.h"
+
+void activation_forward_inplace(double *h, int m, int p, ActivationType act);
+void activation_backward_inplace(double *g, double *h, int total, ActivationType act);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef HOGWILD_TRAINER_H
+#define HOGWILD_TRAINER_H
+
+#include <pthread.h>
+#include "../arena.h"
+#include "../pipeline/pipeline_types.h"
+#include "minibatch.h"
+#include "trainer.h"
+
+typedef struct HogwildTrainer HogwildTrainer;
+
+typedef struct {
+	HogwildTrainer *owner;
+	Arena *arena;
+	double *x_batch;
+	double *y_batch;
+	double loss_sum;
+	int n_steps;
+	int n_samples;
+} HogwildWorker;
+
+struct HogwildTrainer {
+	DenseLayer *layers;
+	int n_layers;
+	LossType loss;
+	int batch_size;
+	double lr;
+	int n_threads;
+	HogwildWorker *workers;
+	pthread_t *threads;
+	BatchIterator *it;
+};
+
+HogwildTrainer *hogwild_trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr, int n_threads);
+EpochStats hogwild_train_epoch(HogwildTrainer *t, BatchIterator *it);
+void hogwild_trainer_destroy(HogwildTrainer *t);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef MEMORY_PLAN_H
+#define MEMORY_PLAN_H
+
+#include "../arena.h"
+#include "../pipeline/pipeline_types.h"
+
+#define PLAN_ALIGNMENT 64
+
+typedef struct {
+	u64 size;
+	u64 offset;
+	int first;
+	int last;
+} PlanBuffer;
+
+typedef struct {
+	PlanBuffer *buffers;
+	int n_buffers;
+	int n_ops;
+	int n_layers;
+	int batch_size;
+	int input;
+	int target;
+	int *hidden;
+	int *grad;
+	int *d_weights;
+	int *recompute;
+	int checkpoint_every;
+	u64 total_bytes;
+	u64 naive_bytes;
+} MemoryPlan;
+
+MemoryPlan *memory_plan_create(DenseLayer *layers, int n_layers, int batch_size);
+MemoryPlan *memory_plan_create_checkpointed(DenseLayer *layers, int n_layers, int batch_size, int checkpoint_every);
+double *memory_plan_buffer(MemoryPlan *plan, void *base, int id);
+void memory_plan_destroy(MemoryPlan *plan);
+
+#endif
@@ -0,0 +1,22 @@
+#ifndef MINIBATCH_H
+#define MINIBATCH_H
+
+typedef struct {
+	double *features;
+	double *targets;
+	int n_samples;
+	int n_features;
+	int n_targets;
+	int batch_size;
+	int *order;
+	int cursor;
+} BatchIterator;
+
+BatchIterator *batch_iterator_create(double *features, double *targets, int n_samples, int n_features, int n_targets, int batch_size);
+void batch_iterator_shuffle(BatchIterator *it);
+void batch_iterator_reset(BatchIterator *it);
+int batch_iterator_next(BatchIterator *it, double *x_out, double *y_out);
+int batch_iterator_next_shared(BatchIterator *it, double *x_out, double *y_out);
+void batch_iterator_destroy(BatchIterator *it);
+
+#endif
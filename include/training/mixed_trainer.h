@@ -0,0 +1,38 @@
+#ifndef MIXED_TRAINER_H
+#define MIXED_TRAINER_H
+
+#include "../arena.h"
+#include "../pipeline/pipeline_types.h"
+#include "minibatch.h"
+#include "trainer.h"
+
+#define MIXED_INIT_SCALE 65536.0
+#define MIXED_GROWTH_INTERVAL 2000
+
+typedef struct {
+	DenseLayer *layers;
+	int n_layers;
+	LossType loss;
+	int batch_size;
+	double lr;
+	Arena *arena;
+	float **w_f;
+	float **h;
+	float **g;
+	float **dw;
+	float *x_f;
+	double loss_scale;
+	int growth_interval;
+	int good_steps;
+	int n_skipped;
+	double *x_batch;
+	double *y_batch;
+} MixedTrainer;
+
+MixedTrainer *mixed_trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr);
+void mixed_trainer_sync(MixedTrainer *t);
+double mixed_train_step(MixedTrainer *t, double *x, double *y, int m);
+EpochStats mixed_train_epoch(MixedTrainer *t, BatchIterator *it);
+void mixed_trainer_destroy(MixedTrainer *t);
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef PARALLEL_TRAINER_H
+#define PARALLEL_TRAINER_H
+
+#include <pthread.h>
+#include "../arena.h"
+#include "../pipeline/pipeline_types.h"
+#include "minibatch.h"
+#include "trainer.h"
+
+typedef struct {
+	pthread_mutex_t lock;
+	pthread_cond_t cond;
+	int n_threads;
+	int waiting;
+	unsigned generation;
+} TrainBarrier;
+
+typedef struct ParallelTrainer ParallelTrainer;
+
+typedef struct {
+	ParallelTrainer *owner;
+	int id;
+	Arena *arena;
+	double **acts;
+	double **caches;
+	double **d_weights;
+	int rows;
+	double loss;
+} TrainWorker;
+
+struct ParallelTrainer {
+	DenseLayer *layers;
+	int n_layers;
+	LossType loss;
+	int batch_size;
+	double lr;
+	int n_threads;
+	TrainWorker *workers;
+	pthread_t *threads;
+	TrainBarrier barrier;
+	double *x;
+	double *y;
+	int m;
+	int shutdown;
+	double *x_batch;
+	double *y_batch;
+};
+
+ParallelTrainer *parallel_trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr, int n_threads);
+double parallel_train_step(ParallelTrainer *t, double *x, double *y, int m);
+EpochStats parallel_train_epoch(ParallelTrainer *t, BatchIterator *it);
+void parallel_trainer_destroy(ParallelTrainer *t);
+
+#endif
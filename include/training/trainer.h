@@ -0,0 +1,42 @@
+#ifndef TRAINER_H
+#define TRAINER_H
+
+#include "../arena.h"
+#include "../pipeline/pipeline_types.h"
+#include "minibatch.h"
+#include "memory_plan.h"
+
+typedef struct {
+	DenseLayer *layers;
+	int n_layers;
+	LossType loss;
+	int batch_size;
+	double lr;
+	Arena *arena;
+	MemoryPlan *plan;
+	void *base;
+	double *x_batch;
+	double *y_batch;
+	int accum_steps;
+	int accum_samples;
+	double **grads;
+} Trainer;
+
+typedef struct {
+	double loss;
+	int n_steps;
+	int n_samples;
+	double seconds;
+	double samples_per_sec;
+} EpochStats;
+
+Trainer *trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr);
+double train_step(Trainer *t, double *x, double *y, int m);
+int trainer_set_accumulation(Trainer *t, int steps);
+int trainer_set_checkpointing(Trainer *t, int every);
+double train_accumulate(Trainer *t, double *x, double *y, int m);
+void train_apply(Trainer *t);
+EpochStats train_epoch(Trainer *t, BatchIterator *it);
+void trainer_destroy(Trainer *t);
+
+#endif
@@ -0,0 +1,60 @@
+#include "../../include/arena.h"
+
+#if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define SCRATCH_THREAD_LOCAL _Thread_local
+#else
+#define SCRATCH_THREAD_LOCAL __thread
+#endif
+
+#define SCRATCH_COUNT 2
+
+// growable, two per thread, so a kernel handed one scratch arena as its output can still use the other
+static SCRATCH_THREAD_LOCAL Arena *scratch_arenas[SCRATCH_COUNT];
+
+ArenaTemp arena_scratch_begin(Arena **conflicts, int n_conflicts){
+
+	ArenaTemp temp = {NULL, 0};
+
+	for (int i = 0; i < SCRATCH_COUNT; i++){
+
+		if (!scratch_arenas[i])
+			scratch_arenas[i] = arena_create_ex(ARENA_SCRATCH_CAPACITY, ARENA_GROWABLE);
+
+		Arena *candidate = scratch_arenas[i];
+		if (!candidate) continue;
+
+		int conflict = 0;
+		for (int j = 0; j < n_conflicts; j++){
+
+			if (conflicts[j] == candidate){
+
+				conflict = 1;
+				break;
+
+			}
+
+		}
+
+		if (!conflict)
+			return arena_temp_begin(candidate);
+
+	}
+
+	return temp;
+
+}
+
+void arena_scratch_release(void){
+
+	for (int i = 0; i < SCRATCH_COUNT; i++){
+
+		if (scratch_arenas[i]){
+
+			arena_destroy(scratch_arenas[i]);
+			scratch_arenas[i] = NULL;
+
+		}
+
+	}
+
+}
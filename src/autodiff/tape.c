@@ -0,0 +1,442 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../../include/autodiff/tape.h"
+#include "../../include/linalg/matricies/gemm.h"
+#include "../../include/activations/relu.h"
+#include "../../include/activations/sigmoid.h"
+#include "../../include/loss/mse_loss.h"
+#include "../../include/loss/cross_entropy.h"
+
+#define TAPE_INITIAL_NODES 64
+
+Tape *tape_create(Arena *arena){
+
+	Tape *tape = malloc(sizeof(*tape));
+	if (!tape) return NULL;
+
+	tape->nodes = malloc(TAPE_INITIAL_NODES * sizeof(TapeNode));
+	if (!tape->nodes){
+
+		free(tape);
+		return NULL;
+
+	}
+
+	tape->arena = arena;
+	tape->capacity = TAPE_INITIAL_NODES;
+	tape->n_nodes = 0;
+	tape->mark = arena_pos(arena);
+	tape->free_list = NULL;
+	tape->bytes_in_use = 0;
+	tape->peak_bytes = 0;
+
+	return tape;
+
+}
+
+void tape_reset(Tape *tape){
+
+	arena_pop_to(tape->arena, tape->mark);
+
+	tape->n_nodes = 0;
+	tape->free_list = NULL;
+	tape->bytes_in_use = 0;
+	tape->peak_bytes = 0;
+
+}
+
+void tape_destroy(Tape *tape){
+
+	if (!tape) return;
+
+	free(tape->nodes);
+	free(tape);
+
+}
+
+// Buffers freed during backward go on a free list threaded through the
+// buffers themselves; later allocations take the first block that fits
+// without wasting more than half of it, and fall back to the arena.
+double *tape_alloc(Tape *tape, u64 bytes, u64 *size_out){
+
+	u64 size = arena_align_up(bytes > sizeof(TapeFreeBlock) ? bytes : sizeof(TapeFreeBlock), ALIGNMENT);
+	TapeFreeBlock **link = &tape->free_list;
+	void *ptr = NULL;
+
+	while (*link){
+
+		TapeFreeBlock *block = *link;
+
+		if (block->size >= size && block->size / 2 <= size){
+
+			*link = block->next;
+			size = block->size;
+			ptr = block;
+			break;
+
+		}
+
+		link = &block->next;
+
+	}
+
+	if (!ptr) ptr = arena_push(tape->arena, size);
+	if (!ptr) return NULL;
+
+	tape->bytes_in_use += size;
+	if (tape->bytes_in_use > tape->peak_bytes)
+		tape->peak_bytes = tape->bytes_in_use;
+
+	*size_out = size;
+
+	return ptr;
+
+}
+
+void tape_free(Tape *tape, double *ptr, u64 size){
+
+	if (!ptr || size == 0) return;
+
+	TapeFreeBlock *block = (TapeFreeBlock *)ptr;
+	block->size = size;
+	block->next = tape->free_list;
+	tape->free_list = block;
+
+	tape->bytes_in_use -= size;
+
+}
+
+static int valid(Tape *tape, int id){
+
+	return id >= 0 && id < tape->n_nodes;
+
+}
+
+static TapeNode *push_node(Tape *tape, TapeOp op, int a, int b, int rows, int cols, u64 value_doubles){
+
+	if (tape->n_nodes == tape->capacity){
+
+		TapeNode *grown = realloc(tape->nodes, 2 * tape->capacity * sizeof(TapeNode));
+		if (!grown) return NULL;
+
+		tape->nodes = grown;
+		tape->capacity *= 2;
+
+	}
+
+	TapeNode *node = &tape->nodes[tape->n_nodes];
+	node->op = op;
+	node->a = a;
+	node->b = b;
+	node->rows = rows;
+	node->cols = cols;
+	node->scalar = 0.0;
+	node->value = NULL;
+	node->grad = NULL;
+	node->value_bytes = 0;
+	node->grad_bytes = 0;
+	node->requires_grad = (valid(tape, a) && tape->nodes[a].requires_grad)
+	                   || (valid(tape, b) && tape->nodes[b].requires_grad);
+
+	if (value_doubles > 0){
+
+		node->value = tape_alloc(tape, value_doubles * sizeof(double), &node->value_bytes);
+		if (!node->value) return NULL;
+
+	}
+
+	tape->n_nodes++;
+
+	return node;
+
+}
+
+static int leaf(Tape *tape, TapeOp op, double *data, int rows, int cols){
+
+	TapeNode *node = push_node(tape, op, -1, -1, rows, cols, 0);
+	if (!node) return -1;
+
+	node->value = data;
+	node->requires_grad = op == TAPE_PARAM;
+
+	return tape->n_nodes - 1;
+
+}
+
+int tape_input(Tape *tape, double *data, int rows, int cols){
+
+	return leaf(tape, TAPE_INPUT, data, rows, cols);
+
+}
+
+int tape_param(Tape *tape, double *data, int rows, int cols){
+
+	return leaf(tape, TAPE_PARAM, data, rows, cols);
+
+}
+
+int tape_matmul(Tape *tape, int a, int b){
+
+	if (!valid(tape, a) || !valid(tape, b)) return -1;
+
+	int m = tape->nodes[a].rows;
+	int n = tape->nodes[a].cols;
+	int p = tape->nodes[b].cols;
+	if (tape->nodes[b].rows != n) return -1;
+
+	TapeNode *node = push_node(tape, TAPE_MATMUL, a, b, m, p, (u64)m * p);
+	if (!node) return -1;
+
+	gemm(node->value, tape->nodes[a].value, tape->nodes[b].value, m, n, p, 0, 0, 1.0, 0.0);
+
+	return tape->n_nodes - 1;
+
+}
+
+// a and b have the same shape, or b is a single row broadcast over a's rows
+static int elementwise(Tape *tape, TapeOp op, int a, int b){
+
+	if (!valid(tape, a) || !valid(tape, b)) return -1;
+
+	TapeNode *na = &tape->nodes[a];
+	TapeNode *nb = &tape->nodes[b];
+	int rows = na->rows;
+	int cols = na->cols;
+
+	if (nb->cols != cols) return -1;
+	if (nb->rows != rows && !(nb->rows == 1 && op != TAPE_MUL)) return -1;
+
+	TapeNode *node = push_node(tape, op, a, b, rows, cols, (u64)rows * cols);
+	if (!node) return -1;
+
+	// push_node may have moved the node array
+	double *x = tape->nodes[a].value;
+	double *y = tape->nodes[b].value;
+	int stride = tape->nodes[b].rows == 1 ? 0 : cols;
+
+	for (int i = 0; i < rows; i++){
+
+		double *out = node->value + (size_t)i * cols;
+		double *xr = x + (size_t)i * cols;
+		double *yr = y + (size_t)i * stride;
+
+		if (op == TAPE_ADD){
+
+			for (int j = 0; j < cols; j++) out[j] = xr[j] + yr[j];
+
+		} else if (op == TAPE_SUB){
+
+			for (int j = 0; j < cols; j++) out[j] = xr[j] - yr[j];
+
+		} else {
+
+			for (int j = 0; j < cols; j++) out[j] = xr[j] * yr[j];
+
+		}
+
+	}
+
+	return tape->n_nodes - 1;
+
+}
+
+int tape_add(Tape *tape, int a, int b){
+
+	return elementwise(tape, TAPE_ADD, a, b);
+
+}
+
+int tape_sub(Tape *tape, int a, int b){
+
+	return elementwise(tape, TAPE_SUB, a, b);
+
+}
+
+int tape_mul(Tape *tape, int a, int b){
+
+	return elementwise(tape, TAPE_MUL, a, b);
+
+}
+
+static int unary(Tape *tape, TapeOp op, int a, double s){
+
+	if (!valid(tape, a)) return -1;
+
+	int rows = tape->nodes[a].rows;
+	int cols = tape->nodes[a].cols;
+	int total = rows * cols;
+
+	TapeNode *node = push_node(tape, op, a, -1, rows, cols, (u64)total);
+	if (!node) return -1;
+
+	double *x = tape->nodes[a].value;
+	double *y = node->value;
+	node->scalar = s;
+
+	if (op == TAPE_SCALE){
+
+		for (int i = 0; i < total; i++) y[i] = s * x[i];
+
+	} else if (op == TAPE_RELU){
+
+		for (int i = 0; i < total; i++) y[i] = relu(x[i]);
+
+	} else if (op == TAPE_SIGMOID){
+
+		for (int i = 0; i < total; i++) y[i] = sigmoid(x[i]);
+
+	} else if (op == TAPE_TANH){
+
+		for (int i = 0; i < total; i++) y[i] = tanh(x[i]);
+
+	} else {
+
+		for (int i = 0; i < rows; i++){
+
+			double *xr = x + (size_t)i * cols;
+			double *yr = y + (size_t)i * cols;
+
+			double max = xr[0];
+			for (int j = 1; j < cols; j++)
+				if (xr[j] > max) max = xr[j];
+
+			double sum = 0.0;
+			for (int j = 0; j < cols; j++){
+
+				yr[j] = exp(xr[j] - max);
+				sum += yr[j];
+
+			}
+
+			for (int j = 0; j < cols; j++)
+				yr[j] /= sum;
+
+		}
+
+	}
+
+	return tape->n_nodes - 1;
+
+}
+
+int tape_scale(Tape *tape, int a, double s){
+
+	return unary(tape, TAPE_SCALE, a, s);
+
+}
+
+int tape_relu(Tape *tape, int a){
+
+	return unary(tape, TAPE_RELU, a, 0.0);
+
+}
+
+int tape_sigmoid(Tape *tape, int a){
+
+	return unary(tape, TAPE_SIGMOID, a, 0.0);
+
+}
+
+int tape_tanh(Tape *tape, int a){
+
+	return unary(tape, TAPE_TANH, a, 0.0);
+
+}
+
+int tape_softmax(Tape *tape, int a){
+
+	return unary(tape, TAPE_SOFTMAX, a, 0.0);
+
+}
+
+// Loss nodes are 1x1. The fused softmax cross-entropy keeps its
+// probabilities right after the loss value for the backward pass.
+static int loss(Tape *tape, TapeOp op, int pred, int target){
+
+	if (!valid(tape, pred) || !valid(tape, target)) return -1;
+
+	int rows = tape->nodes[pred].rows;
+	int cols = tape->nodes[pred].cols;
+	int total = rows * cols;
+
+	if (tape->nodes[target].rows != rows || tape->nodes[target].cols != cols) return -1;
+
+	u64 extra = op == TAPE_SOFTMAX_CROSS_ENTROPY ? (u64)total : 0;
+	TapeNode *node = push_node(tape, op, pred, target, 1, 1, 1 + extra);
+	if (!node) return -1;
+
+	double *x = tape->nodes[pred].value;
+	double *t = tape->nodes[target].value;
+
+	if (op == TAPE_MSE){
+
+		node->value[0] = mse_loss(x, t, total);
+
+	} else if (op == TAPE_CROSS_ENTROPY){
+
+		node->value[0] = cross_entropy(x, t, total);
+
+	} else {
+
+		double *probs = node->value + 1;
+
+		for (int i = 0; i < rows; i++){
+
+			double *xr = x + (size_t)i * cols;
+			double *pr = probs + (size_t)i * cols;
+
+			double max = xr[0];
+			for (int j = 1; j < cols; j++)
+				if (xr[j] > max) max = xr[j];
+
+			double sum = 0.0;
+			for (int j = 0; j < cols; j++){
+
+				pr[j] = exp(xr[j] - max);
+				sum += pr[j];
+
+			}
+
+			for (int j = 0; j < cols; j++)
+				pr[j] /= sum;
+
+		}
+
+		node->value[0] = cross_entropy(probs, t, total);
+
+	}
+
+	return tape->n_nodes - 1;
+
+}
+
+int tape_mse(Tape *tape, int pred, int target){
+
+	return loss(tape, TAPE_MSE, pred, target);
+
+}
+
+int tape_cross_entropy(Tape *tape, int pred, int target){
+
+	return loss(tape, TAPE_CROSS_ENTROPY, pred, target);
+
+}
+
+int tape_softmax_cross_entropy(Tape *tape, int logits, int target){
+
+	return loss(tape, TAPE_SOFTMAX_CROSS_ENTROPY, logits, target);
+
+}
+
+double *tape_value(Tape *tape, int id){
+
+	return valid(tape, id) ? tape->nodes[id].value : NULL;
+
+}
+
+double *tape_grad(Tape *tape, int id){
+
+	return valid(tape, id) ? tape->nodes[id].grad : NULL;
+
+}
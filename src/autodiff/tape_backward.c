@@ -0,0 +1,296 @@
+#include <string.h>
+#include <math.h>
+#include "../../include/autodiff/tape.h"
+#include "../../include/linalg/matricies/gemm.h"
+
+static int owns_value(TapeNode *node){
+
+	return node->op != TAPE_INPUT && node->op != TAPE_PARAM;
+
+}
+
+static void release_value(Tape *tape, TapeNode *node){
+
+	if (!owns_value(node) || !node->value) return;
+
+	tape_free(tape, node->value, node->value_bytes);
+	node->value = NULL;
+	node->value_bytes = 0;
+
+}
+
+// gradient buffer of an input, zeroed on first use; NULL if the input needs none
+static double *grad_of(Tape *tape, int id){
+
+	TapeNode *node = &tape->nodes[id];
+	if (!node->requires_grad) return NULL;
+
+	if (!node->grad){
+
+		u64 total = (u64)node->rows * node->cols;
+		node->grad = tape_alloc(tape, total * sizeof(double), &node->grad_bytes);
+		if (node->grad) memset(node->grad, 0, total * sizeof(double));
+
+	}
+
+	return node->grad;
+
+}
+
+// marks the nodes whose forward values some backward rule reads
+static void mark_needed(Tape *tape, int loss, u8 *needed){
+
+	for (int c = 0; c <= loss; c++){
+
+		TapeNode *node = &tape->nodes[c];
+		if (!node->requires_grad) continue;
+
+		int a_req = node->a >= 0 && tape->nodes[node->a].requires_grad;
+		int b_req = node->b >= 0 && tape->nodes[node->b].requires_grad;
+
+		switch (node->op){
+
+		case TAPE_MATMUL:
+		case TAPE_MUL:
+			if (b_req) needed[node->a] = 1;
+			if (a_req) needed[node->b] = 1;
+			break;
+
+		case TAPE_RELU:
+		case TAPE_SIGMOID:
+		case TAPE_TANH:
+		case TAPE_SOFTMAX:
+			needed[c] = 1;
+			break;
+
+		case TAPE_MSE:
+		case TAPE_CROSS_ENTROPY:
+			needed[node->a] = 1;
+			needed[node->b] = 1;
+			break;
+
+		case TAPE_SOFTMAX_CROSS_ENTROPY:
+			needed[c] = 1;
+			needed[node->b] = 1;
+			break;
+
+		default:
+			break;
+
+		}
+
+	}
+
+}
+
+// g_in (+)= g_out, summing over rows when the input was broadcast
+static void accumulate(double *g_in, double *g_out, int in_rows, int rows, int cols, double sign){
+
+	if (in_rows == rows){
+
+		int total = rows * cols;
+		for (int i = 0; i < total; i++)
+			g_in[i] += sign * g_out[i];
+
+		return;
+
+	}
+
+	for (int i = 0; i < rows; i++)
+		for (int j = 0; j < cols; j++)
+			g_in[j] += sign * g_out[(size_t)i * cols + j];
+
+}
+
+static void backward_node(Tape *tape, int id){
+
+	TapeNode *node = &tape->nodes[id];
+	TapeNode *na = node->a >= 0 ? &tape->nodes[node->a] : NULL;
+	TapeNode *nb = node->b >= 0 ? &tape->nodes[node->b] : NULL;
+	double *g = node->grad;
+	double *y = node->value;
+	int rows = node->rows;
+	int cols = node->cols;
+	int total = rows * cols;
+
+	double *ga = na ? grad_of(tape, node->a) : NULL;
+	double *gb = nb ? grad_of(tape, node->b) : NULL;
+
+	switch (node->op){
+
+	case TAPE_MATMUL: {
+
+		int n = na->cols;
+		if (ga) gemm(ga, g, nb->value, rows, cols, n, 0, 1, 1.0, 1.0);
+		if (gb) gemm(gb, na->value, g, n, rows, cols, 1, 0, 1.0, 1.0);
+		break;
+
+	}
+
+	case TAPE_ADD:
+	case TAPE_SUB:
+		if (ga) accumulate(ga, g, rows, rows, cols, 1.0);
+		if (gb) accumulate(gb, g, nb->rows, rows, cols, node->op == TAPE_ADD ? 1.0 : -1.0);
+		break;
+
+	case TAPE_MUL:
+		if (ga) for (int i = 0; i < total; i++) ga[i] += g[i] * nb->value[i];
+		if (gb) for (int i = 0; i < total; i++) gb[i] += g[i] * na->value[i];
+		break;
+
+	case TAPE_SCALE:
+		if (ga) for (int i = 0; i < total; i++) ga[i] += node->scalar * g[i];
+		break;
+
+	case TAPE_RELU:
+		if (ga) for (int i = 0; i < total; i++) if (y[i] > 0.0) ga[i] += g[i];
+		break;
+
+	case TAPE_SIGMOID:
+		if (ga) for (int i = 0; i < total; i++) ga[i] += g[i] * y[i] * (1.0 - y[i]);
+		break;
+
+	case TAPE_TANH:
+		if (ga) for (int i = 0; i < total; i++) ga[i] += g[i] * (1.0 - y[i] * y[i]);
+		break;
+
+	case TAPE_SOFTMAX:
+		if (!ga) break;
+		for (int i = 0; i < rows; i++){
+
+			double *yr = y + (size_t)i * cols;
+			double *gr = g + (size_t)i * cols;
+
+			double dot = 0.0;
+			for (int j = 0; j < cols; j++) dot += gr[j] * yr[j];
+
+			for (int j = 0; j < cols; j++)
+				ga[(size_t)i * cols + j] += yr[j] * (gr[j] - dot);
+
+		}
+		break;
+
+	case TAPE_MSE: {
+
+		int n = na->rows * na->cols;
+		double s = g[0] * 2.0 / n;
+		for (int i = 0; i < n; i++){
+
+			double diff = na->value[i] - nb->value[i];
+			if (ga) ga[i] += s * diff;
+			if (gb) gb[i] -= s * diff;
+
+		}
+		break;
+
+	}
+
+	case TAPE_CROSS_ENTROPY: {
+
+		int n = na->rows * na->cols;
+		double s = g[0] / n;
+		for (int i = 0; i < n; i++){
+
+			double p = na->value[i] + 1e-15;
+			if (ga) ga[i] -= s * nb->value[i] / p;
+			if (gb) gb[i] -= s * log(p);
+
+		}
+		break;
+
+	}
+
+	case TAPE_SOFTMAX_CROSS_ENTROPY: {
+
+		// d/dz of -sum t log softmax(z) / n is (p * sum_k t_k - t) / n per row
+		int m = na->rows;
+		int c = na->cols;
+		int n = m * c;
+		double s = g[0] / n;
+		double *probs = y + 1;
+		double *t = nb->value;
+
+		for (int i = 0; i < m; i++){
+
+			double *pr = probs + (size_t)i * c;
+			double *tr = t + (size_t)i * c;
+
+			double t_sum = 0.0;
+			for (int j = 0; j < c; j++) t_sum += tr[j];
+
+			for (int j = 0; j < c; j++){
+
+				if (ga) ga[(size_t)i * c + j] += s * (pr[j] * t_sum - tr[j]);
+				if (gb) gb[(size_t)i * c + j] -= s * log(pr[j] + 1e-15);
+
+			}
+
+		}
+		break;
+
+	}
+
+	default:
+		break;
+
+	}
+
+}
+
+int tape_backward(Tape *tape, int loss){
+
+	if (loss < 0 || loss >= tape->n_nodes) return -1;
+
+	TapeNode *out = &tape->nodes[loss];
+	if (out->rows != 1 || out->cols != 1 || !out->requires_grad) return -1;
+
+	ArenaTemp scratch = arena_scratch_begin(&tape->arena, 1);
+	if (!scratch.arena) return -1;
+
+	u8 *needed = arena_push(scratch.arena, tape->n_nodes);
+	if (!needed){
+
+		arena_scratch_end(scratch);
+		return -1;
+
+	}
+
+	memset(needed, 0, tape->n_nodes);
+	mark_needed(tape, loss, needed);
+	needed[loss] = 1;
+
+	// values no backward rule reads are dead already; hand them to the free list
+	for (int i = 0; i < tape->n_nodes; i++)
+		if (!needed[i] || i > loss) release_value(tape, &tape->nodes[i]);
+
+	arena_scratch_end(scratch);
+
+	double *seed = grad_of(tape, loss);
+	if (!seed) return -1;
+	seed[0] = 1.0;
+
+	// a node's consumers all have higher ids, so once its own rule has run
+	// nothing reads its value or gradient again
+	for (int id = loss; id >= 0; id--){
+
+		TapeNode *node = &tape->nodes[id];
+
+		if (node->grad && node->op != TAPE_INPUT && node->op != TAPE_PARAM)
+			backward_node(tape, id);
+
+		node = &tape->nodes[id];
+		if (id != loss) release_value(tape, node);
+
+		if (node->op != TAPE_PARAM && node->grad){
+
+			tape_free(tape, node->grad, node->grad_bytes);
+			node->grad = NULL;
+			node->grad_bytes = 0;
+
+		}
+
+	}
+
+	return 0;
+
+}
@@ -0,0 +1,700 @@
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include "../../include/autodiff/tape_plan.h"
+#include "../../include/linalg/matricies/gemm.h"
+#include "../../include/activations/relu.h"
+#include "../../include/activations/sigmoid.h"
+
+static int is_leaf(TapeNode *node){
+
+	return node->op == TAPE_INPUT || node->op == TAPE_PARAM;
+
+}
+
+static int is_loss(TapeOp op){
+
+	return op == TAPE_MSE || op == TAPE_CROSS_ENTROPY || op == TAPE_SOFTMAX_CROSS_ENTROPY;
+
+}
+
+static int by_output(const void *x, const void *y){
+
+	return ((const FusedGroup *)x)->out - ((const FusedGroup *)y)->out;
+
+}
+
+static double *push_doubles(Arena *arena, u64 count, int zero){
+
+	double *buf = arena_push(arena, count * sizeof(double));
+	if (buf && zero) memset(buf, 0, count * sizeof(double));
+
+	return buf;
+
+}
+
+// Splits the live part of the tape into chains. A chain starts at a matmul
+// (the anchor, computed a row tile at a time straight into the tile buffer)
+// or at the first elementwise op on some value, and absorbs each following
+// op whose only input from the chain is operand a of a value nobody else
+// reads. Operands of a chain op other than the chain value are always the
+// output of another chain, and a chain's output has the largest id in it, so
+// sorting by output id gives an order in which every operand exists.
+static int build_groups(TapePlan *plan, Arena *scratch){
+
+	TapeNode *nodes = plan->nodes;
+	int n = plan->n_nodes;
+
+	u8 *live = arena_push(scratch, n);
+	int *refs = arena_push(scratch, n * sizeof(int));
+	int *consumer = arena_push(scratch, n * sizeof(int));
+	int *group_of = arena_push(scratch, n * sizeof(int));
+	if (!live || !refs || !consumer || !group_of) return -1;
+
+	memset(live, 0, n);
+	memset(refs, 0, n * sizeof(int));
+	live[plan->loss] = 1;
+
+	for (int id = plan->loss; id >= 0; id--){
+
+		group_of[id] = -1;
+		if (!live[id] || is_leaf(&nodes[id])) continue;
+
+		int a = nodes[id].a;
+		int b = nodes[id].b;
+		live[a] = 1;
+		refs[a]++;
+		consumer[a] = id;
+
+		if (b >= 0){
+
+			live[b] = 1;
+			refs[b]++;
+			consumer[b] = id;
+
+		}
+
+	}
+
+	plan->groups = arena_push(plan->arena, n * sizeof(FusedGroup));
+	int *ops = arena_push(plan->arena, n * sizeof(int));
+	if (!plan->groups || !ops) return -1;
+
+	plan->n_groups = 0;
+
+	for (int id = 0; id < n; id++){
+
+		if (!live[id] || is_leaf(&nodes[id]) || group_of[id] >= 0) continue;
+
+		FusedGroup *g = &plan->groups[plan->n_groups];
+		g->ops = ops;
+		g->n_ops = 0;
+		g->anchored = nodes[id].op == TAPE_MATMUL;
+		g->head = g->anchored ? id : nodes[id].a;
+		if (!g->anchored) g->ops[g->n_ops++] = id;
+
+		group_of[id] = plan->n_groups;
+		int tail = id;
+
+		while (!is_loss(nodes[tail].op) && refs[tail] == 1){
+
+			int c = consumer[tail];
+			if (nodes[c].op == TAPE_MATMUL || nodes[c].a != tail || nodes[c].b == tail) break;
+
+			g->ops[g->n_ops++] = c;
+			group_of[c] = plan->n_groups;
+			tail = c;
+
+		}
+
+		g->out = tail;
+		ops += g->n_ops;
+		plan->n_groups++;
+
+	}
+
+	qsort(plan->groups, plan->n_groups, sizeof(FusedGroup), by_output);
+
+	// a parameter read once, as the right operand of a matmul or of an
+	// add/sub, is read by no later rule, so its update is written through
+	for (int id = 0; id < n; id++){
+
+		plan->fused_update[id] = 0;
+		if (nodes[id].op != TAPE_PARAM || refs[id] != 1) continue;
+
+		TapeNode *c = &nodes[consumer[id]];
+		plan->fused_update[id] = c->b == id && (c->op == TAPE_MATMUL || c->op == TAPE_ADD || c->op == TAPE_SUB);
+
+	}
+
+	return 0;
+
+}
+
+// Values are stored only where the backward rules or another chain read
+// them; everything else lives in the tile buffer for one tile at a time.
+// Gradients are kept for chain heads, matmul operands and side operands.
+static int allocate(TapePlan *plan, Arena *scratch){
+
+	TapeNode *nodes = plan->nodes;
+	int n = plan->n_nodes;
+
+	u8 *store = arena_push(scratch, n);
+	u8 *keep_grad = arena_push(scratch, n);
+	if (!store || !keep_grad) return -1;
+
+	memset(store, 0, n);
+	memset(keep_grad, 0, n);
+
+	int widest = 0;
+
+	for (int i = 0; i < plan->n_groups; i++){
+
+		FusedGroup *g = &plan->groups[i];
+		TapeNode *head = &nodes[g->head];
+
+		keep_grad[g->head] = 1;
+		if (g->anchored){
+
+			keep_grad[head->a] = 1;
+			keep_grad[head->b] = 1;
+
+		}
+
+		if (!is_loss(nodes[g->out].op)) store[g->out] = 1;
+
+		for (int k = 0; k < g->n_ops; k++){
+
+			int id = g->ops[k];
+			int prev = k > 0 ? g->ops[k - 1] : g->head;
+			TapeNode *node = &nodes[id];
+
+			switch (node->op){
+
+			case TAPE_RELU:
+			case TAPE_SIGMOID:
+			case TAPE_TANH:
+			case TAPE_SOFTMAX:
+				if (node->requires_grad) store[id] = 1;
+				break;
+
+			case TAPE_MUL:
+				if (nodes[node->b].requires_grad) store[prev] = 1;
+				keep_grad[node->b] = 1;
+				break;
+
+			case TAPE_ADD:
+			case TAPE_SUB:
+				keep_grad[node->b] = 1;
+				break;
+
+			case TAPE_MSE:
+			case TAPE_CROSS_ENTROPY:
+				store[prev] = 1;
+				break;
+
+			default:
+				break;
+
+			}
+
+		}
+
+		int cols = head->cols;
+		g->tile_rows = cols >= TAPE_PLAN_TILE ? 1 : TAPE_PLAN_TILE / cols;
+		if (g->tile_rows > head->rows) g->tile_rows = head->rows;
+		if (g->tile_rows * cols > widest) widest = g->tile_rows * cols;
+
+	}
+
+	for (int id = 0; id < n; id++){
+
+		TapeNode *node = &nodes[id];
+		u64 total = (u64)node->rows * node->cols;
+
+		if (is_loss(node->op)){
+
+			u64 probs = node->op == TAPE_SOFTMAX_CROSS_ENTROPY ? (u64)nodes[node->a].rows * nodes[node->a].cols : 0;
+			node->value = push_doubles(plan->arena, 1 + probs, 1);
+			if (!node->value) return -1;
+
+		} else if (store[id] && !is_leaf(node)){
+
+			node->value = push_doubles(plan->arena, total, 0);
+			if (!node->value) return -1;
+
+		}
+
+		if (keep_grad[id] && node->requires_grad && !plan->fused_update[id]){
+
+			node->grad = push_doubles(plan->arena, total, 1);
+			if (!node->grad) return -1;
+
+			// parameter gradients are cleared by the update itself
+			node->grad_bytes = node->op == TAPE_PARAM ? 0 : total * sizeof(double);
+
+		}
+
+	}
+
+	plan->tile = push_doubles(plan->arena, widest, 0);
+	plan->tile_grad = push_doubles(plan->arena, widest, 0);
+
+	return plan->tile && plan->tile_grad ? 0 : -1;
+
+}
+
+TapePlan *tape_plan_compile(Tape *tape, int loss, double lr){
+
+	if (loss < 0 || loss >= tape->n_nodes) return NULL;
+
+	TapeNode *out = &tape->nodes[loss];
+	if (!is_loss(out->op) || !out->requires_grad) return NULL;
+	if (tape->nodes[out->b].requires_grad) return NULL;
+
+	Arena *arena = arena_create_ex(0, ARENA_GROWABLE);
+	if (!arena) return NULL;
+
+	TapePlan *plan = arena_push(arena, sizeof(TapePlan));
+	int n = loss + 1;
+
+	if (plan){
+
+		plan->arena = arena;
+		plan->n_nodes = n;
+		plan->loss = loss;
+		plan->lr = lr;
+		plan->nodes = arena_push(arena, n * sizeof(TapeNode));
+		plan->fused_update = arena_push(arena, n);
+
+	}
+
+	if (!plan || !plan->nodes || !plan->fused_update){
+
+		arena_destroy(arena);
+		return NULL;
+
+	}
+
+	memcpy(plan->nodes, tape->nodes, n * sizeof(TapeNode));
+
+	for (int id = 0; id < n; id++){
+
+		TapeNode *node = &plan->nodes[id];
+		if (!is_leaf(node)) node->value = NULL;
+		node->grad = NULL;
+		node->value_bytes = 0;
+		node->grad_bytes = 0;
+
+	}
+
+	Arena *conflicts[2] = {arena, tape->arena};
+	ArenaTemp scratch = arena_scratch_begin(conflicts, 2);
+	int ok = scratch.arena && build_groups(plan, scratch.arena) == 0 && allocate(plan, scratch.arena) == 0;
+	if (scratch.arena) arena_scratch_end(scratch);
+
+	if (!ok){
+
+		arena_destroy(arena);
+		return NULL;
+
+	}
+
+	return plan;
+
+}
+
+static void softmax_rows(double *dst, double *src, int rows, int cols){
+
+	for (int i = 0; i < rows; i++){
+
+		double *xr = src + (size_t)i * cols;
+		double *yr = dst + (size_t)i * cols;
+
+		double max = xr[0];
+		for (int j = 1; j < cols; j++)
+			if (xr[j] > max) max = xr[j];
+
+		double sum = 0.0;
+		for (int j = 0; j < cols; j++){
+
+			yr[j] = exp(xr[j] - max);
+			sum += yr[j];
+
+		}
+
+		for (int j = 0; j < cols; j++)
+			yr[j] /= sum;
+
+	}
+
+}
+
+// runs the chain over one tile of whole rows held in x; returns the tile's
+// share of the loss sum when the chain ends in a loss
+static double forward_tile(TapePlan *plan, FusedGroup *g, double *x, int r0, int rows, int cols){
+
+	TapeNode *nodes = plan->nodes;
+	size_t off = (size_t)r0 * cols;
+	int total = rows * cols;
+	double sum = 0.0;
+
+	for (int k = 0; k < g->n_ops; k++){
+
+		TapeNode *node = &nodes[g->ops[k]];
+		TapeNode *other = node->b >= 0 ? &nodes[node->b] : NULL;
+		double *y = other ? other->value + (other->rows == 1 ? 0 : off) : NULL;
+		int stride = other && other->rows == 1 ? 0 : cols;
+
+		switch (node->op){
+
+		case TAPE_ADD:
+			for (int i = 0; i < rows; i++)
+				for (int j = 0; j < cols; j++) x[i * cols + j] += y[(size_t)i * stride + j];
+			break;
+
+		case TAPE_SUB:
+			for (int i = 0; i < rows; i++)
+				for (int j = 0; j < cols; j++) x[i * cols + j] -= y[(size_t)i * stride + j];
+			break;
+
+		case TAPE_MUL:
+			for (int i = 0; i < total; i++) x[i] *= y[i];
+			break;
+
+		case TAPE_SCALE:
+			for (int i = 0; i < total; i++) x[i] *= node->scalar;
+			break;
+
+		case TAPE_RELU:
+			for (int i = 0; i < total; i++) x[i] = relu(x[i]);
+			break;
+
+		case TAPE_SIGMOID:
+			for (int i = 0; i < total; i++) x[i] = sigmoid(x[i]);
+			break;
+
+		case TAPE_TANH:
+			for (int i = 0; i < total; i++) x[i] = tanh(x[i]);
+			break;
+
+		case TAPE_SOFTMAX:
+			softmax_rows(x, x, rows, cols);
+			break;
+
+		case TAPE_MSE:
+			for (int i = 0; i < total; i++){
+
+				double diff = x[i] - y[i];
+				sum += diff * diff;
+
+			}
+			break;
+
+		case TAPE_CROSS_ENTROPY:
+			for (int i = 0; i < total; i++) sum -= y[i] * log(x[i] + 1e-15);
+			break;
+
+		case TAPE_SOFTMAX_CROSS_ENTROPY: {
+
+			double *probs = node->value + 1 + off;
+			softmax_rows(probs, x, rows, cols);
+			for (int i = 0; i < total; i++) sum -= y[i] * log(probs[i] + 1e-15);
+			break;
+
+		}
+
+		default:
+			break;
+
+		}
+
+		if (!is_loss(node->op) && node->value)
+			memcpy(node->value + off, x, total * sizeof(double));
+
+	}
+
+	return sum;
+
+}
+
+static void forward_group(TapePlan *plan, FusedGroup *g){
+
+	TapeNode *head = &plan->nodes[g->head];
+	int rows = head->rows;
+	int cols = head->cols;
+	double sum = 0.0;
+
+	for (int r0 = 0; r0 < rows; r0 += g->tile_rows){
+
+		int tr = rows - r0 < g->tile_rows ? rows - r0 : g->tile_rows;
+		size_t off = (size_t)r0 * cols;
+		double *x = plan->tile;
+
+		if (g->anchored){
+
+			TapeNode *na = &plan->nodes[head->a];
+			TapeNode *nb = &plan->nodes[head->b];
+
+			gemm(x, na->value + (size_t)r0 * na->cols, nb->value, tr, na->cols, cols, 0, 0, 1.0, 0.0);
+			if (head->value) memcpy(head->value + off, x, (size_t)tr * cols * sizeof(double));
+
+		} else {
+
+			memcpy(x, head->value + off, (size_t)tr * cols * sizeof(double));
+
+		}
+
+		sum += forward_tile(plan, g, x, r0, tr, cols);
+
+	}
+
+	TapeNode *out = &plan->nodes[g->out];
+	if (is_loss(out->op)) out->value[0] = sum / ((double)rows * cols);
+
+}
+
+// g (+)= scale * d, summing over rows when g is a broadcast row
+static void accumulate(double *g, double *d, int broadcast, int rows, int cols, double scale){
+
+	for (int i = 0; i < rows; i++){
+
+		double *gr = g + (broadcast ? 0 : (size_t)i * cols);
+		for (int j = 0; j < cols; j++) gr[j] += scale * d[i * cols + j];
+
+	}
+
+}
+
+// seeds d with the gradient of the loss with respect to its prediction
+static void loss_tile(TapePlan *plan, TapeNode *node, double *x, double *d, size_t off, int rows, int cols){
+
+	TapeNode *pred = &plan->nodes[node->a];
+	double *t = plan->nodes[node->b].value + off;
+	double s = 1.0 / ((double)pred->rows * pred->cols);
+	int total = rows * cols;
+
+	if (node->op == TAPE_MSE){
+
+		for (int i = 0; i < total; i++) d[i] = 2.0 * s * (x[i] - t[i]);
+
+	} else if (node->op == TAPE_CROSS_ENTROPY){
+
+		for (int i = 0; i < total; i++) d[i] = -s * t[i] / (x[i] + 1e-15);
+
+	} else {
+
+		double *probs = node->value + 1 + off;
+
+		for (int i = 0; i < rows; i++){
+
+			double t_sum = 0.0;
+			for (int j = 0; j < cols; j++) t_sum += t[i * cols + j];
+
+			for (int j = 0; j < cols; j++)
+				d[i * cols + j] = s * (probs[i * cols + j] * t_sum - t[i * cols + j]);
+
+		}
+
+	}
+
+}
+
+// walks the chain backwards over one tile, leaving in d the gradient with
+// respect to the chain head; returns 0 if the walk stopped early at an op
+// that does not depend on a parameter
+static int backward_tile(TapePlan *plan, FusedGroup *g, double *d, int r0, int rows, int cols){
+
+	TapeNode *nodes = plan->nodes;
+	size_t off = (size_t)r0 * cols;
+	int total = rows * cols;
+	int k = g->n_ops - 1;
+
+	if (k >= 0 && is_loss(nodes[g->ops[k]].op)){
+
+		int prev = k > 0 ? g->ops[k - 1] : g->head;
+		loss_tile(plan, &nodes[g->ops[k]], nodes[prev].value + off, d, off, rows, cols);
+		k--;
+
+	} else {
+
+		memcpy(d, nodes[g->out].grad + off, total * sizeof(double));
+
+	}
+
+	for (; k >= 0; k--){
+
+		TapeNode *node = &nodes[g->ops[k]];
+		if (!node->requires_grad) return 0;
+
+		TapeNode *other = node->b >= 0 ? &nodes[node->b] : NULL;
+		double *y = node->value ? node->value + off : NULL;
+
+		switch (node->op){
+
+		case TAPE_ADD:
+		case TAPE_SUB: {
+
+			if (!other->requires_grad) break;
+
+			double sign = node->op == TAPE_ADD ? 1.0 : -1.0;
+			int broadcast = other->rows == 1;
+			double *target = plan->fused_update[node->b] ? other->value : other->grad;
+			double scale = plan->fused_update[node->b] ? -plan->lr * sign : sign;
+
+			accumulate(target + (broadcast ? 0 : off), d, broadcast, rows, cols, scale);
+			break;
+
+		}
+
+		case TAPE_MUL: {
+
+			int prev = k > 0 ? g->ops[k - 1] : g->head;
+			double *w = other->value + off;
+
+			if (other->requires_grad){
+
+				double *x = nodes[prev].value + off;
+				for (int i = 0; i < total; i++) other->grad[off + i] += d[i] * x[i];
+
+			}
+
+			for (int i = 0; i < total; i++) d[i] *= w[i];
+			break;
+
+		}
+
+		case TAPE_SCALE:
+			for (int i = 0; i < total; i++) d[i] *= node->scalar;
+			break;
+
+		case TAPE_RELU:
+			for (int i = 0; i < total; i++) d[i] = y[i] > 0.0 ? d[i] : 0.0;
+			break;
+
+		case TAPE_SIGMOID:
+			for (int i = 0; i < total; i++) d[i] *= y[i] * (1.0 - y[i]);
+			break;
+
+		case TAPE_TANH:
+			for (int i = 0; i < total; i++) d[i] *= 1.0 - y[i] * y[i];
+			break;
+
+		case TAPE_SOFTMAX:
+			for (int i = 0; i < rows; i++){
+
+				double dot = 0.0;
+				for (int j = 0; j < cols; j++) dot += d[i * cols + j] * y[i * cols + j];
+
+				for (int j = 0; j < cols; j++)
+					d[i * cols + j] = y[i * cols + j] * (d[i * cols + j] - dot);
+
+			}
+			break;
+
+		default:
+			break;
+
+		}
+
+	}
+
+	return plan->nodes[g->head].requires_grad;
+
+}
+
+static void backward_group(TapePlan *plan, FusedGroup *g){
+
+	TapeNode *head = &plan->nodes[g->head];
+	if (!plan->nodes[g->out].requires_grad) return;
+
+	int rows = head->rows;
+	int cols = head->cols;
+
+	// an anchor with no chain already holds its output gradient
+	if (!g->anchored || g->n_ops > 0){
+
+		for (int r0 = 0; r0 < rows; r0 += g->tile_rows){
+
+			int tr = rows - r0 < g->tile_rows ? rows - r0 : g->tile_rows;
+			size_t off = (size_t)r0 * cols;
+			double *d = plan->tile_grad;
+
+			if (!backward_tile(plan, g, d, r0, tr, cols)) continue;
+
+			if (g->anchored)
+				memcpy(head->grad + off, d, (size_t)tr * cols * sizeof(double));
+			else
+				accumulate(head->grad + off, d, 0, tr, cols, 1.0);
+
+		}
+
+	}
+
+	if (!g->anchored || !head->requires_grad) return;
+
+	TapeNode *na = &plan->nodes[head->a];
+	TapeNode *nb = &plan->nodes[head->b];
+	int n = na->cols;
+
+	// the input gradient reads the weights before the update overwrites them
+	if (na->requires_grad)
+		gemm(na->grad, head->grad, nb->value, rows, cols, n, 0, 1, 1.0, 1.0);
+
+	if (nb->requires_grad){
+
+		if (plan->fused_update[head->b])
+			gemm(nb->value, na->value, head->grad, n, rows, cols, 1, 0, -plan->lr, 1.0);
+		else
+			gemm(nb->grad, na->value, head->grad, n, rows, cols, 1, 0, 1.0, 1.0);
+
+	}
+
+}
+
+double tape_plan_run(TapePlan *plan){
+
+	TapeNode *nodes = plan->nodes;
+
+	for (int i = 0; i < plan->n_groups; i++)
+		forward_group(plan, &plan->groups[i]);
+
+	for (int id = 0; id < plan->n_nodes; id++)
+		if (nodes[id].grad_bytes) memset(nodes[id].grad, 0, nodes[id].grad_bytes);
+
+	for (int i = plan->n_groups - 1; i >= 0; i--)
+		backward_group(plan, &plan->groups[i]);
+
+	// parameters read more than once take one update-and-clear pass
+	for (int id = 0; id < plan->n_nodes; id++){
+
+		TapeNode *node = &nodes[id];
+		if (node->op != TAPE_PARAM || !node->grad) continue;
+
+		int total = node->rows * node->cols;
+		for (int i = 0; i < total; i++){
+
+			node->value[i] -= plan->lr * node->grad[i];
+			node->grad[i] = 0.0;
+
+		}
+
+	}
+
+	return nodes[plan->loss].value[0];
+
+}
+
+double *tape_plan_value(TapePlan *plan, int id){
+
+	return id >= 0 && id < plan->n_nodes ? plan->nodes[id].value : NULL;
+
+}
+
+void tape_plan_destroy(TapePlan *plan){
+
+	if (!plan) return;
+
+	arena_destroy(plan->arena);
+
+}
@@ -4,9 +4,14 @@
 
 double *matmul_backward_a(Arena *arena, double *dout, double *b, int m, int n, int p){
 
-	double *bt = mattranspose(arena, b, n, p);
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	double *bt = mattranspose(scratch.arena, b, n, p);
 	double *grad = matmul(arena, dout, bt, m, p, n);
 
+	arena_scratch_end(scratch);
+
 	return grad;
 
 }
@@ -4,9 +4,14 @@
 
 double *matmul_backward_b(Arena *arena, double *a, double *dout, int m, int n, int p){
 
-	double *at = mattranspose(arena, a, m, n);
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	double *at = mattranspose(scratch.arena, a, m, n);
 	double *grad = matmul(arena, at, dout, n, m, p);
 
+	arena_scratch_end(scratch);
+
 	return grad;
 
 }
@@ -0,0 +1,98 @@
+#include <stddef.h>
+#include "../../../include/linalg/matricies/gemm.h"
+
+static void scale_rows(double *c, int m, int p, double beta){
+
+	size_t total = (size_t)m * p;
+
+	if (beta == 0.0){
+
+		for (size_t i = 0; i < total; i++)
+			c[i] = 0.0;
+
+	} else if (beta != 1.0){
+
+		for (size_t i = 0; i < total; i++)
+			c[i] *= beta;
+
+	}
+
+}
+
+void gemm(double *c, double *a, double *b, int m, int n, int p, int trans_a, int trans_b, double alpha, double beta){
+
+	if (trans_b && !trans_a){
+
+		// c[i][j] = a row i . b row j, both contiguous
+		for (int i = 0; i < m; i++){
+			for (int j = 0; j < p; j++){
+
+				double sum = 0.0;
+				for (int k = 0; k < n; k++)
+					sum += a[(size_t)i * n + k] * b[(size_t)j * n + k];
+
+				double prev = beta == 0.0 ? 0.0 : beta * c[(size_t)i * p + j];
+				c[(size_t)i * p + j] = prev + alpha * sum;
+
+			}
+		}
+
+		return;
+
+	}
+
+	scale_rows(c, m, p, beta);
+
+	if (trans_a && !trans_b){
+
+		// a is stored n x m: walk it row by row so every access is contiguous
+		for (int k = 0; k < n; k++){
+
+			double *a_row = a + (size_t)k * m;
+			double *b_row = b + (size_t)k * p;
+
+			for (int i = 0; i < m; i++){
+
+				double a_ki = alpha * a_row[i];
+				if (a_ki == 0.0) continue;
+
+				double *c_row = c + (size_t)i * p;
+				for (int j = 0; j < p; j++)
+					c_row[j] += a_ki * b_row[j];
+
+			}
+
+		}
+
+		return;
+
+	}
+
+	for (int i = 0; i < m; i++){
+
+		double *c_row = c + (size_t)i * p;
+
+		for (int k = 0; k < n; k++){
+
+			double a_ik = trans_a ? a[(size_t)k * m + i] : a[(size_t)i * n + k];
+			a_ik *= alpha;
+			if (a_ik == 0.0) continue;
+
+			if (trans_b){
+
+				for (int j = 0; j < p; j++)
+					c_row[j] += a_ik * b[(size_t)j * n + k];
+
+			} else {
+
+				double *b_row = b + (size_t)k * p;
+				for (int j = 0; j < p; j++)
+					c_row[j] += a_ik * b_row[j];
+
+			}
+
+		}
+
+	}
+
+}
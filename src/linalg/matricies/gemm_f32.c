@@ -0,0 +1,98 @@
+#include <stddef.h>
+#include "../../../include/linalg/matricies/gemm_f32.h"
+
+static void scale_rows(float *c, int m, int p, float beta){
+
+	size_t total = (size_t)m * p;
+
+	if (beta == 0.0f){
+
+		for (size_t i = 0; i < total; i++)
+			c[i] = 0.0f;
+
+	} else if (beta != 1.0f){
+
+		for (size_t i = 0; i < total; i++)
+			c[i] *= beta;
+
+	}
+
+}
+
+void gemm_f32(float *c, float *a, float *b, int m, int n, int p, int trans_a, int trans_b, float alpha, float beta){
+
+	if (trans_b && !trans_a){
+
+		// c[i][j] = a row i . b row j, both contiguous
+		for (int i = 0; i < m; i++){
+			for (int j = 0; j < p; j++){
+
+				float sum = 0.0f;
+				for (int k = 0; k < n; k++)
+					sum += a[(size_t)i * n + k] * b[(size_t)j * n + k];
+
+				float prev = beta == 0.0f ? 0.0f : beta * c[(size_t)i * p + j];
+				c[(size_t)i * p + j] = prev + alpha * sum;
+
+			}
+		}
+
+		return;
+
+	}
+
+	scale_rows(c, m, p, beta);
+
+	if (trans_a && !trans_b){
+
+		// a is stored n x m: walk it row by row so every access is contiguous
+		for (int k = 0; k < n; k++){
+
+			float *a_row = a + (size_t)k * m;
+			float *b_row = b + (size_t)k * p;
+
+			for (int i = 0; i < m; i++){
+
+				float a_ki = alpha * a_row[i];
+				if (a_ki == 0.0f) continue;
+
+				float *c_row = c + (size_t)i * p;
+				for (int j = 0; j < p; j++)
+					c_row[j] += a_ki * b_row[j];
+
+			}
+
+		}
+
+		return;
+
+	}
+
+	for (int i = 0; i < m; i++){
+
+		float *c_row = c + (size_t)i * p;
+
+		for (int k = 0; k < n; k++){
+
+			float a_ik = trans_a ? a[(size_t)k * m + i] : a[(size_t)i * n + k];
+			a_ik *= alpha;
+			if (a_ik == 0.0f) continue;
+
+			if (trans_b){
+
+				for (int j = 0; j < p; j++)
+					c_row[j] += a_ik * b[(size_t)j * n + k];
+
+			} else {
+
+				float *b_row = b + (size_t)k * p;
+				for (int j = 0; j < p; j++)
+					c_row[j] += a_ik * b_row[j];
+
+			}
+
+		}
+
+	}
+
+}
@@ -0,0 +1,127 @@
+#include <stdlib.h>
+#include <math.h>
+#include "../../include/optimizers/adam.h"
+
+static AdamState *adam_alloc(int n, double beta1, double beta2, double eps, double weight_decay, int decoupled){
+
+	if (n <= 0) return NULL;
+
+	AdamState *state = malloc(sizeof(*state));
+	if (!state) return NULL;
+
+	// m and v share one allocation
+	state->m = calloc(2 * (size_t)n, sizeof(double));
+	if (!state->m){
+
+		free(state);
+		return NULL;
+
+	}
+
+	state->v = state->m + n;
+	state->n = n;
+	state->t = 0;
+	state->beta1 = beta1;
+	state->beta2 = beta2;
+	state->eps = eps;
+	state->weight_decay = weight_decay;
+	state->decoupled = decoupled;
+
+	return state;
+
+}
+
+AdamState *adam_create(int n, double beta1, double beta2, double eps, double weight_decay){
+
+	return adam_alloc(n, beta1, beta2, eps, weight_decay, 0);
+
+}
+
+AdamState *adamw_create(int n, double beta1, double beta2, double eps, double weight_decay){
+
+	return adam_alloc(n, beta1, beta2, eps, weight_decay, 1);
+
+}
+
+void adam_update(AdamState *state, double *weights, double *grads, double lr){
+
+	double *restrict w = weights;
+	double *restrict g = grads;
+	double *restrict m = state->m;
+	double *restrict v = state->v;
+	double b1 = state->beta1;
+	double b2 = state->beta2;
+	double eps = state->eps;
+	int n = state->n;
+
+	state->t++;
+
+	// bias corrections folded into the step size and epsilon:
+	// lr * m_hat / (sqrt(v_hat) + eps) = step * m / (sqrt(v) + eps_hat)
+	double c1 = 1.0 - pow(b1, state->t);
+	double c2 = sqrt(1.0 - pow(b2, state->t));
+	double step = lr * c2 / c1;
+	double eps_hat = eps * c2;
+
+	double l2 = state->decoupled ? 0.0 : state->weight_decay;
+	double decay = state->decoupled ? 1.0 - lr * state->weight_decay : 1.0;
+
+	for (int i = 0; i < n; i++){
+
+		double gi = g[i] + l2 * w[i];
+		m[i] = b1 * m[i] + (1.0 - b1) * gi;
+		v[i] = b2 * v[i] + (1.0 - b2) * gi * gi;
+		w[i] = decay * w[i] - step * m[i] / (sqrt(v[i]) + eps_hat);
+
+	}
+
+}
+
+// Lazy Adam: the step counter advances every call, but the moments of
+// rows absent from grad are neither decayed nor applied, so a step costs
+// the touched rows only. Touched rows get exactly the dense update.
+void adam_update_sparse(AdamState *state, double *table, SparseGrad *grad, double lr){
+
+	double b1 = state->beta1;
+	double b2 = state->beta2;
+	int dim = grad->dim;
+
+	state->t++;
+
+	double c1 = 1.0 - pow(b1, state->t);
+	double c2 = sqrt(1.0 - pow(b2, state->t));
+	double step = lr * c2 / c1;
+	double eps_hat = state->eps * c2;
+
+	double l2 = state->decoupled ? 0.0 : state->weight_decay;
+	double decay = state->decoupled ? 1.0 - lr * state->weight_decay : 1.0;
+
+	for (int r = 0; r < grad->n_rows; r++){
+
+		size_t base = (size_t)grad->rows[r] * dim;
+		double *restrict w = table + base;
+		double *restrict m = state->m + base;
+		double *restrict v = state->v + base;
+		double *restrict g = grad->values + (size_t)r * dim;
+
+		for (int j = 0; j < dim; j++){
+
+			double gj = g[j] + l2 * w[j];
+			m[j] = b1 * m[j] + (1.0 - b1) * gj;
+			v[j] = b2 * v[j] + (1.0 - b2) * gj * gj;
+			w[j] = decay * w[j] - step * m[j] / (sqrt(v[j]) + eps_hat);
+
+		}
+
+	}
+
+}
+
+void adam_destroy(AdamState *state){
+
+	if (!state) return;
+
+	free(state->m);
+	free(state);
+
+}
@@ -0,0 +1,95 @@
+#include <stdlib.h>
+#include "../../include/optimizers/momentum.h"
+
+MomentumState *momentum_create(int n, double momentum, double weight_decay, int nesterov){
+
+	if (n <= 0) return NULL;
+
+	MomentumState *state = malloc(sizeof(*state));
+	if (!state) return NULL;
+
+	state->velocity = calloc(n, sizeof(double));
+	if (!state->velocity){
+
+		free(state);
+		return NULL;
+
+	}
+
+	state->n = n;
+	state->momentum = momentum;
+	state->weight_decay = weight_decay;
+	state->nesterov = nesterov;
+
+	return state;
+
+}
+
+void momentum_update(MomentumState *state, double *weights, double *grads, double lr){
+
+	double *restrict w = weights;
+	double *restrict g = grads;
+	double *restrict v = state->velocity;
+	double mu = state->momentum;
+	double wd = state->weight_decay;
+	int n = state->n;
+
+	if (state->nesterov){
+
+		for (int i = 0; i < n; i++){
+
+			double gi = g[i] + wd * w[i];
+			v[i] = mu * v[i] + gi;
+			w[i] -= lr * (gi + mu * v[i]);
+
+		}
+
+	} else {
+
+		for (int i = 0; i < n; i++){
+
+			double gi = g[i] + wd * w[i];
+			v[i] = mu * v[i] + gi;
+			w[i] -= lr * v[i];
+
+		}
+
+	}
+
+}
+
+// velocity of rows absent from grad is left untouched rather than decayed,
+// so a step costs the touched rows only
+void momentum_update_sparse(MomentumState *state, double *table, SparseGrad *grad, double lr){
+
+	double mu = state->momentum;
+	double wd = state->weight_decay;
+	int dim = grad->dim;
+
+	for (int r = 0; r < grad->n_rows; r++){
+
+		size_t base = (size_t)grad->rows[r] * dim;
+		double *restrict w = table + base;
+		double *restrict v = state->velocity + base;
+		double *restrict g = grad->values + (size_t)r * dim;
+
+		for (int j = 0; j < dim; j++){
+
+			double gj = g[j] + wd * w[j];
+			v[j] = mu * v[j] + gj;
+			w[j] -= lr * (state->nesterov ? gj + mu * v[j] : v[j]);
+
+		}
+
+	}
+
+}
+
+void momentum_destroy(MomentumState *state){
+
+	if (!state) return;
+
+	free(state->velocity);
+	free(state);
+
+}
@@ -0,0 +1,83 @@
+#include <stdlib.h>
+#include <math.h>
+#include "../../include/optimizers/rmsprop.h"
+
+RMSPropState *rmsprop_create(int n, double decay, double eps, double weight_decay){
+
+	if (n <= 0) return NULL;
+
+	RMSPropState *state = malloc(sizeof(*state));
+	if (!state) return NULL;
+
+	state->sq_avg = calloc(n, sizeof(double));
+	if (!state->sq_avg){
+
+		free(state);
+		return NULL;
+
+	}
+
+	state->n = n;
+	state->decay = decay;
+	state->eps = eps;
+	state->weight_decay = weight_decay;
+
+	return state;
+
+}
+
+void rmsprop_update(RMSPropState *state, double *weights, double *grads, double lr){
+
+	double *restrict w = weights;
+	double *restrict g = grads;
+	double *restrict s = state->sq_avg;
+	double rho = state->decay;
+	double eps = state->eps;
+	double wd = state->weight_decay;
+	int n = state->n;
+
+	for (int i = 0; i < n; i++){
+
+		double gi = g[i] + wd * w[i];
+		s[i] = rho * s[i] + (1.0 - rho) * gi * gi;
+		w[i] -= lr * gi / (sqrt(s[i]) + eps);
+
+	}
+
+}
+
+// squared averages of rows absent from grad are left as they are
+void rmsprop_update_sparse(RMSPropState *state, double *table, SparseGrad *grad, double lr){
+
+	double rho = state->decay;
+	double eps = state->eps;
+	double wd = state->weight_decay;
+	int dim = grad->dim;
+
+	for (int r = 0; r < grad->n_rows; r++){
+
+		size_t base = (size_t)grad->rows[r] * dim;
+		double *restrict w = table + base;
+		double *restrict s = state->sq_avg + base;
+		double *restrict g = grad->values + (size_t)r * dim;
+
+		for (int j = 0; j < dim; j++){
+
+			double gj = g[j] + wd * w[j];
+			s[j] = rho * s[j] + (1.0 - rho) * gj * gj;
+			w[j] -= lr * gj / (sqrt(s[j]) + eps);
+
+		}
+
+	}
+
+}
+
+void rmsprop_destroy(RMSPropState *state){
+
+	if (!state) return;
+
+	free(state->sq_avg);
+	free(state);
+
+}
@@ -13,3 +13,19 @@ double *sgd_update(Arena *arena, double *weights, double *grads, double lr, int
 	return result;
 
 }
+
+// in place: only the rows listed in grad are read or written
+void sgd_update_sparse(double *table, SparseGrad *grad, double lr){
+
+	int dim = grad->dim;
+
+	for (int r = 0; r < grad->n_rows; r++){
+
+		double *w = table + (size_t)grad->rows[r] * dim;
+		double *g = grad->values + (size_t)r * dim;
+
+		for (int j = 0; j < dim; j++) w[j] -= lr * g[j];
+
+	}
+
+}
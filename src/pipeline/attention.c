@@ -0,0 +1,190 @@
+#include <math.h>
+#include <string.h>
+#include "../../include/pipeline/attention.h"
+#include "../../include/linalg/matricies/gemm.h"
+
+// out = softmax(q k^T / sqrt(d)) v, one query tile at a time. Each key
+// tile's scores live only in an ATTENTION_TILE x ATTENTION_TILE scratch
+// block: rows keep a running max and sum, and when the max grows the
+// partial output row is rescaled before the tile's p v is added. lse
+// receives max + log(sum) per query row for the backward pass.
+double *attention_forward(Arena *arena, double *q, double *k, double *v, int seq_q, int seq_k, int d, int dv, double **lse){
+
+	double scale = 1.0 / sqrt((double)d);
+
+	double *out = arena_push(arena, (size_t)seq_q * dv * sizeof(double));
+	double *row_lse = lse ? arena_push(arena, seq_q * sizeof(double)) : NULL;
+	if (!out || (lse && !row_lse)) return NULL;
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	double *s = arena_push(scratch.arena, (ATTENTION_TILE * ATTENTION_TILE + 2 * ATTENTION_TILE) * sizeof(double));
+	if (!s){
+
+		arena_scratch_end(scratch);
+		return NULL;
+
+	}
+
+	double *row_max = s + ATTENTION_TILE * ATTENTION_TILE;
+	double *row_sum = row_max + ATTENTION_TILE;
+
+	memset(out, 0, (size_t)seq_q * dv * sizeof(double));
+
+	for (int i0 = 0; i0 < seq_q; i0 += ATTENTION_TILE){
+
+		int bq = seq_q - i0 < ATTENTION_TILE ? seq_q - i0 : ATTENTION_TILE;
+		double *o = out + (size_t)i0 * dv;
+
+		for (int r = 0; r < bq; r++){
+
+			row_max[r] = -INFINITY;
+			row_sum[r] = 0.0;
+
+		}
+
+		for (int j0 = 0; j0 < seq_k; j0 += ATTENTION_TILE){
+
+			int bk = seq_k - j0 < ATTENTION_TILE ? seq_k - j0 : ATTENTION_TILE;
+
+			gemm(s, q + (size_t)i0 * d, k + (size_t)j0 * d, bq, d, bk, 0, 1, scale, 0.0);
+
+			for (int r = 0; r < bq; r++){
+
+				double *sr = s + r * bk;
+				double *orow = o + (size_t)r * dv;
+
+				double max = row_max[r];
+				for (int c = 0; c < bk; c++)
+					if (sr[c] > max) max = sr[c];
+
+				double sum = 0.0;
+				for (int c = 0; c < bk; c++){
+
+					sr[c] = exp(sr[c] - max);
+					sum += sr[c];
+
+				}
+
+				double correction = exp(row_max[r] - max);
+				if (correction != 1.0)
+					for (int c = 0; c < dv; c++) orow[c] *= correction;
+
+				row_sum[r] = row_sum[r] * correction + sum;
+				row_max[r] = max;
+
+			}
+
+			gemm(o, s, v + (size_t)j0 * dv, bq, bk, dv, 0, 0, 1.0, 1.0);
+
+		}
+
+		for (int r = 0; r < bq; r++){
+
+			double inv = 1.0 / row_sum[r];
+			double *orow = o + (size_t)r * dv;
+
+			for (int c = 0; c < dv; c++) orow[c] *= inv;
+			if (row_lse) row_lse[i0 + r] = row_max[r] + log(row_sum[r]);
+
+		}
+
+	}
+
+	arena_scratch_end(scratch);
+
+	if (lse) *lse = row_lse;
+
+	return out;
+
+}
+
+// The probabilities of each tile are rebuilt from the scores and lse
+// rather than stored. With delta = rowsum(dout * out), a tile contributes
+//   d_v += p^T dout,  ds = p * (dout v^T - delta),
+//   d_q += scale * ds k,  d_k += scale * ds^T q.
+AttentionGrad attention_backward(Arena *arena, double *dout, double *q, double *k, double *v, double *out, double *lse, int seq_q, int seq_k, int d, int dv){
+
+	AttentionGrad grad = {NULL, NULL, NULL};
+	double scale = 1.0 / sqrt((double)d);
+
+	double *d_q = arena_push(arena, (size_t)seq_q * d * sizeof(double));
+	double *d_k = arena_push(arena, (size_t)seq_k * d * sizeof(double));
+	double *d_v = arena_push(arena, (size_t)seq_k * dv * sizeof(double));
+	if (!d_q || !d_k || !d_v) return grad;
+
+	memset(d_q, 0, (size_t)seq_q * d * sizeof(double));
+	memset(d_k, 0, (size_t)seq_k * d * sizeof(double));
+	memset(d_v, 0, (size_t)seq_k * dv * sizeof(double));
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return grad;
+
+	double *p = arena_push(scratch.arena, (2 * ATTENTION_TILE * ATTENTION_TILE + ATTENTION_TILE) * sizeof(double));
+	if (!p){
+
+		arena_scratch_end(scratch);
+		return grad;
+
+	}
+
+	double *dp = p + ATTENTION_TILE * ATTENTION_TILE;
+	double *delta = dp + ATTENTION_TILE * ATTENTION_TILE;
+
+	for (int i0 = 0; i0 < seq_q; i0 += ATTENTION_TILE){
+
+		int bq = seq_q - i0 < ATTENTION_TILE ? seq_q - i0 : ATTENTION_TILE;
+		double *qi = q + (size_t)i0 * d;
+		double *doi = dout + (size_t)i0 * dv;
+
+		for (int r = 0; r < bq; r++){
+
+			double *gr = doi + (size_t)r * dv;
+			double *orow = out + (size_t)(i0 + r) * dv;
+
+			delta[r] = 0.0;
+			for (int c = 0; c < dv; c++) delta[r] += gr[c] * orow[c];
+
+		}
+
+		for (int j0 = 0; j0 < seq_k; j0 += ATTENTION_TILE){
+
+			int bk = seq_k - j0 < ATTENTION_TILE ? seq_k - j0 : ATTENTION_TILE;
+			double *kj = k + (size_t)j0 * d;
+
+			gemm(p, qi, kj, bq, d, bk, 0, 1, scale, 0.0);
+			gemm(dp, doi, v + (size_t)j0 * dv, bq, dv, bk, 0, 1, 1.0, 0.0);
+
+			for (int r = 0; r < bq; r++){
+
+				double *pr = p + r * bk;
+				double *dr = dp + r * bk;
+				double l = lse[i0 + r];
+
+				for (int c = 0; c < bk; c++){
+
+					pr[c] = exp(pr[c] - l);
+					dr[c] = pr[c] * (dr[c] - delta[r]);
+
+				}
+
+			}
+
+			gemm(d_v + (size_t)j0 * dv, p, doi, bk, bq, dv, 1, 0, 1.0, 1.0);
+			gemm(d_q + (size_t)i0 * d, dp, kj, bq, bk, d, 0, 0, scale, 1.0);
+			gemm(d_k + (size_t)j0 * d, dp, qi, bk, bq, d, 1, 0, scale, 1.0);
+
+		}
+
+	}
+
+	arena_scratch_end(scratch);
+
+	grad.d_q = d_q;
+	grad.d_k = d_k;
+	grad.d_v = d_v;
+
+	return grad;
+
+}
@@ -0,0 +1,164 @@
+#include <math.h>
+#include "../../include/pipeline/batch_norm.h"
+#include "../../include/statistics/column_stats.h"
+
+void batch_norm_init(BatchNormLayer *bn, double *params, int n_features){
+
+	bn->gamma = params;
+	bn->beta = params + n_features;
+	bn->running_mean = params + 2 * n_features;
+	bn->running_var = params + 3 * n_features;
+	bn->n_features = n_features;
+	bn->momentum = BATCH_NORM_MOMENTUM;
+	bn->eps = BATCH_NORM_EPS;
+
+	for (int j = 0; j < n_features; j++){
+
+		bn->gamma[j] = 1.0;
+		bn->beta[j] = 0.0;
+		bn->running_mean[j] = 0.0;
+		bn->running_var[j] = 1.0;
+
+	}
+
+}
+
+// In training mode the batch statistics come from one row-major sweep and
+// fold into the running averages; inference uses the running averages.
+// Either way the output pass is y = x * scale + shift per column.
+double *batch_norm_forward(Arena *arena, BatchNormLayer *bn, double *input, int m, int training, BatchNormCache *cache){
+
+	int p = bn->n_features;
+	int total = m * p;
+
+	double *out = arena_push(arena, total * sizeof(double));
+	double *inv_std = arena_push(arena, p * sizeof(double));
+	double *x_hat = cache ? arena_push(arena, total * sizeof(double)) : NULL;
+	if (!out || !inv_std || (cache && !x_hat)) return NULL;
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	double *mean = arena_push(scratch.arena, 3 * p * sizeof(double));
+	if (!mean){
+
+		arena_scratch_end(scratch);
+		return NULL;
+
+	}
+
+	double *scale = mean + p;
+	double *shift = mean + 2 * p;
+
+	if (training){
+
+		double *var = shift;
+		column_moments(input, m, p, mean, var);
+
+		double unbias = m > 1 ? (double)m / (m - 1) : 1.0;
+		for (int j = 0; j < p; j++){
+
+			bn->running_mean[j] += bn->momentum * (mean[j] - bn->running_mean[j]);
+			bn->running_var[j] += bn->momentum * (var[j] * unbias - bn->running_var[j]);
+			inv_std[j] = 1.0 / sqrt(var[j] + bn->eps);
+
+		}
+
+	} else {
+
+		for (int j = 0; j < p; j++){
+
+			mean[j] = bn->running_mean[j];
+			inv_std[j] = 1.0 / sqrt(bn->running_var[j] + bn->eps);
+
+		}
+
+	}
+
+	for (int j = 0; j < p; j++){
+
+		scale[j] = bn->gamma[j] * inv_std[j];
+		shift[j] = bn->beta[j] - mean[j] * scale[j];
+
+	}
+
+	for (int i = 0; i < m; i++){
+
+		double *xr = input + (size_t)i * p;
+		double *yr = out + (size_t)i * p;
+
+		for (int j = 0; j < p; j++)
+			yr[j] = xr[j] * scale[j] + shift[j];
+
+		if (x_hat){
+
+			double *hr = x_hat + (size_t)i * p;
+			for (int j = 0; j < p; j++)
+				hr[j] = (xr[j] - mean[j]) * inv_std[j];
+
+		}
+
+	}
+
+	arena_scratch_end(scratch);
+
+	if (cache){
+
+		cache->x_hat = x_hat;
+		cache->inv_std = inv_std;
+
+	}
+
+	return out;
+
+}
+
+// d_input = gamma * inv_std / m * (m * dout - sum(dout) - x_hat * sum(dout * x_hat)),
+// where the two column sums are exactly d_beta and d_gamma
+double *batch_norm_backward(Arena *arena, BatchNormLayer *bn, double *dout, BatchNormCache *cache, int m, double *d_gamma, double *d_beta){
+
+	int p = bn->n_features;
+	double *x_hat = cache->x_hat;
+
+	double *d_input = arena_push(arena, (size_t)m * p * sizeof(double));
+	if (!d_input) return NULL;
+
+	for (int j = 0; j < p; j++){
+
+		d_gamma[j] = 0.0;
+		d_beta[j] = 0.0;
+
+	}
+
+	for (int i = 0; i < m; i++){
+
+		double *dr = dout + (size_t)i * p;
+		double *hr = x_hat + (size_t)i * p;
+
+		for (int j = 0; j < p; j++){
+
+			d_beta[j] += dr[j];
+			d_gamma[j] += dr[j] * hr[j];
+
+		}
+
+	}
+
+	for (int i = 0; i < m; i++){
+
+		double *dr = dout + (size_t)i * p;
+		double *hr = x_hat + (size_t)i * p;
+		double *gr = d_input + (size_t)i * p;
+
+		for (int j = 0; j < p; j++){
+
+			double k = bn->gamma[j] * cache->inv_std[j] / m;
+			gr[j] = k * (m * dr[j] - d_beta[j] - hr[j] * d_gamma[j]);
+
+		}
+
+	}
+
+	return d_input;
+
+}
@@ -1,25 +1,44 @@
+#include <math.h>
 #include "../../include/pipeline/batch_normalize.h"
-#include "../../include/statistics/normalize.h"
-#include <string.h>
+#include "../../include/statistics/column_stats.h"
 
+// Two row-major passes: one for every column's moments, one for the output.
+// Only the per-feature moments are kept besides the result.
 double *batch_normalize(Arena *arena, double *features, int n_samples, int n_features){
 
-	double *result = arena_push(arena, n_samples * n_features * sizeof(double));
+	double *result = arena_push(arena, (size_t)n_samples * n_features * sizeof(double));
+	if (!result) return NULL;
 
-	double col[n_samples];
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
 
-	for (int j = 0; j < n_features; j++){
+	double *mean = arena_push(scratch.arena, 2 * (size_t)n_features * sizeof(double));
+	if (!mean){
 
-		for (int i = 0; i < n_samples; i++)
-			col[i] = features[i * n_features + j];
+		arena_scratch_end(scratch);
+		return NULL;
 
-		double *normed = normalize(arena, col, n_samples);
+	}
+
+	double *inv_std = mean + n_features;
+
+	column_moments(features, n_samples, n_features, mean, inv_std);
+
+	for (int j = 0; j < n_features; j++)
+		inv_std[j] = 1.0 / sqrt(inv_std[j]);
 
-		for (int i = 0; i < n_samples; i++)
-			result[i * n_features + j] = normed[i];
+	for (int i = 0; i < n_samples; i++){
+
+		double *xr = features + (size_t)i * n_features;
+		double *yr = result + (size_t)i * n_features;
+
+		for (int j = 0; j < n_features; j++)
+			yr[j] = (xr[j] - mean[j]) * inv_std[j];
 
 	}
 
+	arena_scratch_end(scratch);
+
 	return result;
 
 }
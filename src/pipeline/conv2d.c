@@ -0,0 +1,111 @@
+#include <string.h>
+#include "../../include/pipeline/conv2d.h"
+#include "../../include/pipeline/im2col.h"
+#include "../../include/linalg/matricies/gemm.h"
+
+// Each sample is unfolded into a (channels * k * k) x (out_h * out_w)
+// column matrix on the scratch arena, so the convolution is one GEMM with
+// the filters x (channels * k * k) weights and lands directly in
+// filters x out_h x out_w layout.
+double *conv2d_forward(Arena *arena, double *input, double *weights, double *bias, int m, Window2d *shape, int filters){
+
+	int oh = window_out(shape->height, shape->kernel, shape->stride, shape->padding);
+	int ow = window_out(shape->width, shape->kernel, shape->stride, shape->padding);
+	int spatial = oh * ow;
+	int patch = shape->channels * shape->kernel * shape->kernel;
+	size_t in_size = (size_t)shape->channels * shape->height * shape->width;
+	size_t out_size = (size_t)filters * spatial;
+
+	double *out = arena_push(arena, m * out_size * sizeof(double));
+	if (!out) return NULL;
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	double *cols = arena_push(scratch.arena, (size_t)patch * spatial * sizeof(double));
+	if (!cols){
+
+		arena_scratch_end(scratch);
+		return NULL;
+
+	}
+
+	for (int s = 0; s < m; s++){
+
+		double *o = out + s * out_size;
+
+		im2col(cols, input + s * in_size, shape);
+		gemm(o, weights, cols, filters, patch, spatial, 0, 0, 1.0, 0.0);
+
+		if (bias)
+			for (int f = 0; f < filters; f++)
+				for (int i = 0; i < spatial; i++)
+					o[(size_t)f * spatial + i] += bias[f];
+
+	}
+
+	arena_scratch_end(scratch);
+
+	return out;
+
+}
+
+// The columns are rebuilt from the input one sample at a time rather than
+// cached, so the backward pass also holds a single sample's columns.
+ConvGrad conv2d_backward(Arena *arena, double *dout, double *input, double *weights, int m, Window2d *shape, int filters){
+
+	ConvGrad grad = {NULL, NULL, NULL};
+
+	int oh = window_out(shape->height, shape->kernel, shape->stride, shape->padding);
+	int ow = window_out(shape->width, shape->kernel, shape->stride, shape->padding);
+	int spatial = oh * ow;
+	int patch = shape->channels * shape->kernel * shape->kernel;
+	size_t in_size = (size_t)shape->channels * shape->height * shape->width;
+	size_t out_size = (size_t)filters * spatial;
+
+	double *d_weights = arena_push(arena, (size_t)filters * patch * sizeof(double));
+	double *d_bias = arena_push(arena, filters * sizeof(double));
+	double *d_input = arena_push(arena, m * in_size * sizeof(double));
+	if (!d_weights || !d_bias || !d_input) return grad;
+
+	memset(d_weights, 0, (size_t)filters * patch * sizeof(double));
+	memset(d_bias, 0, filters * sizeof(double));
+	memset(d_input, 0, m * in_size * sizeof(double));
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return grad;
+
+	double *cols = arena_push(scratch.arena, 2 * (size_t)patch * spatial * sizeof(double));
+	if (!cols){
+
+		arena_scratch_end(scratch);
+		return grad;
+
+	}
+
+	double *d_cols = cols + (size_t)patch * spatial;
+
+	for (int s = 0; s < m; s++){
+
+		double *d = dout + s * out_size;
+
+		im2col(cols, input + s * in_size, shape);
+		gemm(d_weights, d, cols, filters, spatial, patch, 0, 1, 1.0, 1.0);
+		gemm(d_cols, weights, d, patch, filters, spatial, 1, 0, 1.0, 0.0);
+		col2im(d_input + s * in_size, d_cols, shape);
+
+		for (int f = 0; f < filters; f++)
+			for (int i = 0; i < spatial; i++)
+				d_bias[f] += d[(size_t)f * spatial + i];
+
+	}
+
+	arena_scratch_end(scratch);
+
+	grad.d_weights = d_weights;
+	grad.d_bias = d_bias;
+	grad.d_input = d_input;
+
+	return grad;
+
+}
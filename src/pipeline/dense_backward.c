@@ -10,19 +10,30 @@ LayerGrad dense_backward(Arena *arena, double *dout, double *input, double *weig
 	int total = m * p;
 	double *d_act = dout;
 
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena){
+
+		grad.d_weights = NULL;
+		grad.d_input = NULL;
+		return grad;
+
+	}
+
 	if (act == ACTIVATION_RELU){
 
-		d_act = relu_backward(arena, dout, cache, total);
+		d_act = relu_backward(scratch.arena, dout, cache, total);
 
 	} else if (act == ACTIVATION_SIGMOID){
 
-		d_act = sigmoid_backward(arena, dout, cache, total);
+		d_act = sigmoid_backward(scratch.arena, dout, cache, total);
 
 	}
 
 	grad.d_weights = matmul_backward_b(arena, input, d_act, m, n, p);
 	grad.d_input = matmul_backward_a(arena, d_act, weights, m, n, p);
 
+	arena_scratch_end(scratch);
+
 	return grad;
 
 }
@@ -0,0 +1,35 @@
+#include "../../include/pipeline/dense_backward_accumulate.h"
+#include "../../include/backward/activations/relu_backward.h"
+#include "../../include/backward/activations/sigmoid_backward.h"
+#include "../../include/backward/linalg/matmul_backward_a.h"
+#include "../../include/linalg/matricies/gemm.h"
+
+double *dense_backward_accumulate(Arena *arena, double *dout, double *input, double *weights, double *cache, double *d_weights, int m, int n, int p, ActivationType act){
+
+	int total = m * p;
+	double *d_act = dout;
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	if (act == ACTIVATION_RELU){
+
+		d_act = relu_backward(scratch.arena, dout, cache, total);
+
+	} else if (act == ACTIVATION_SIGMOID){
+
+		d_act = sigmoid_backward(scratch.arena, dout, cache, total);
+
+	}
+
+	double *d_input = matmul_backward_a(arena, d_act, weights, m, n, p);
+
+	// d_weights += input^T @ d_act, accumulated by the GEMM itself (beta = 1)
+	if (d_input && d_act)
+		gemm(d_weights, input, d_act, n, m, p, 1, 0, 1.0, 1.0);
+
+	arena_scratch_end(scratch);
+
+	return d_input;
+
+}
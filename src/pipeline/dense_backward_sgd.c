@@ -0,0 +1,72 @@
+#include <stddef.h>
+#include "../../include/pipeline/dense_backward_sgd.h"
+#include "../../include/backward/activations/relu_backward.h"
+#include "../../include/backward/activations/sigmoid_backward.h"
+#include "../../include/backward/linalg/matmul_backward_a.h"
+
+// weights -= lr * input^T @ d_act, one tile of weight rows at a time:
+// each tile stays in cache while every sample's contribution is folded in
+static void sgd_write_through(double *weights, double *input, double *d_act, int m, int n, int p, double lr){
+
+	for (int i0 = 0; i0 < n; i0 += DENSE_SGD_TILE){
+
+		int i1 = i0 + DENSE_SGD_TILE < n ? i0 + DENSE_SGD_TILE : n;
+
+		for (int k = 0; k < m; k++){
+
+			double *x_row = input + (size_t)k * n;
+			double *d_row = d_act + (size_t)k * p;
+
+			for (int i = i0; i < i1; i++){
+
+				double a = lr * x_row[i];
+				if (a == 0.0) continue;
+
+				double *w_row = weights + (size_t)i * p;
+				for (int j = 0; j < p; j++)
+					w_row[j] -= a * d_row[j];
+
+			}
+
+		}
+
+	}
+
+}
+
+double *dense_backward_sgd(Arena *arena, double *dout, double *input, double *weights, double *cache, int m, int n, int p, ActivationType act, double lr){
+
+	int total = m * p;
+	double *d_act = dout;
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	if (act == ACTIVATION_RELU){
+
+		d_act = relu_backward(scratch.arena, dout, cache, total);
+
+	} else if (act == ACTIVATION_SIGMOID){
+
+		d_act = sigmoid_backward(scratch.arena, dout, cache, total);
+
+	}
+
+	if (!d_act){
+
+		arena_scratch_end(scratch);
+		return NULL;
+
+	}
+
+	// d_input needs the weights from before the update
+	double *d_input = matmul_backward_a(arena, d_act, weights, m, n, p);
+
+	if (d_input)
+		sgd_write_through(weights, input, d_act, m, n, p, lr);
+
+	arena_scratch_end(scratch);
+
+	return d_input;
+
+}
@@ -0,0 +1,74 @@
+#include "../../include/pipeline/dropout.h"
+#include "../../include/random/philox.h"
+
+// Bit b of word w keeps element 64 * w + b. The 64 draws for word w are
+// Philox blocks 16w .. 16w + 15 of stream `step`, so a mask depends only on
+// (seed, step) and any word can be rebuilt on its own.
+void dropout_mask(u64 *mask, int n, double rate, u64 seed, u64 step){
+
+	u64 threshold = (u64)((1.0 - rate) * 4294967296.0);
+	u64 words = DROPOUT_MASK_WORDS(n);
+	u32 draws[64];
+
+	for (u64 w = 0; w < words; w++){
+
+		philox_fill(draws, 64, seed, step, 16 * w);
+
+		u64 bits = 0;
+		for (int b = 0; b < 64; b++)
+			bits |= (u64)(draws[b] < threshold) << b;
+
+		mask[w] = bits;
+
+	}
+
+	// clear the bits past n so popcounts over the mask are exact
+	if (n % 64) mask[words - 1] &= ((u64)1 << (n % 64)) - 1;
+
+}
+
+static void apply_mask(double *out, double *in, u64 *mask, int n, double scale){
+
+	for (int i = 0; i < n; i += 64){
+
+		u64 bits = mask[i / 64];
+		int end = n - i < 64 ? n - i : 64;
+
+		for (int b = 0; b < end; b++)
+			out[i + b] = (bits >> b) & 1 ? in[i + b] * scale : 0.0;
+
+	}
+
+}
+
+// inverted dropout: kept elements are scaled by 1 / (1 - rate) during
+// training so inference needs no rescaling
+double *dropout_forward(Arena *arena, double *input, int n, double rate, u64 seed, u64 step, u64 **mask){
+
+	if (rate < 0.0 || rate >= 1.0) return NULL;
+
+	double *out = arena_push(arena, n * sizeof(double));
+	u64 *bits = arena_push(arena, DROPOUT_MASK_WORDS(n) * sizeof(u64));
+	if (!out || !bits) return NULL;
+
+	dropout_mask(bits, n, rate, seed, step);
+	apply_mask(out, input, bits, n, 1.0 / (1.0 - rate));
+
+	if (mask) *mask = bits;
+
+	return out;
+
+}
+
+double *dropout_backward(Arena *arena, double *dout, u64 *mask, int n, double rate){
+
+	if (rate < 0.0 || rate >= 1.0) return NULL;
+
+	double *d_input = arena_push(arena, n * sizeof(double));
+	if (!d_input) return NULL;
+
+	apply_mask(d_input, dout, mask, n, 1.0 / (1.0 - rate));
+
+	return d_input;
+
+}
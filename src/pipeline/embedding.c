@@ -0,0 +1,99 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/pipeline/embedding.h"
+
+typedef struct {
+	int id;
+	int pos;
+} IdPos;
+
+static int by_id(const void *x, const void *y){
+
+	const IdPos *a = x;
+	const IdPos *b = y;
+
+	if (a->id != b->id) return a->id < b->id ? -1 : 1;
+	return a->pos - b->pos;
+
+}
+
+double *embedding_forward(Arena *arena, double *table, int *ids, int n_ids, int dim){
+
+	double *out = arena_push(arena, (size_t)n_ids * dim * sizeof(double));
+	if (!out) return NULL;
+
+	for (int i = 0; i < n_ids; i++)
+		memcpy(out + (size_t)i * dim, table + (size_t)ids[i] * dim, dim * sizeof(double));
+
+	return out;
+
+}
+
+// Sorting the (id, position) pairs groups repeated ids, so each touched row
+// appears once with the sum of its gradients; the cost depends on the
+// batch only, never on the size of the table.
+SparseGrad embedding_backward(Arena *arena, double *dout, int *ids, int n_ids, int dim){
+
+	SparseGrad grad = {NULL, NULL, 0, dim};
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return grad;
+
+	IdPos *order = arena_push(scratch.arena, n_ids * sizeof(IdPos));
+	if (!order){
+
+		arena_scratch_end(scratch);
+		return grad;
+
+	}
+
+	for (int i = 0; i < n_ids; i++){
+
+		order[i].id = ids[i];
+		order[i].pos = i;
+
+	}
+
+	qsort(order, n_ids, sizeof(IdPos), by_id);
+
+	int unique = 0;
+	for (int i = 0; i < n_ids; i++)
+		if (i == 0 || order[i].id != order[i - 1].id) unique++;
+
+	int *rows = arena_push(arena, unique * sizeof(int));
+	double *values = arena_push(arena, (size_t)unique * dim * sizeof(double));
+	if (!rows || !values){
+
+		arena_scratch_end(scratch);
+		return grad;
+
+	}
+
+	int r = -1;
+	for (int i = 0; i < n_ids; i++){
+
+		double *src = dout + (size_t)order[i].pos * dim;
+
+		if (i == 0 || order[i].id != order[i - 1].id){
+
+			rows[++r] = order[i].id;
+			memcpy(values + (size_t)r * dim, src, dim * sizeof(double));
+
+		} else {
+
+			double *dst = values + (size_t)r * dim;
+			for (int j = 0; j < dim; j++) dst[j] += src[j];
+
+		}
+
+	}
+
+	arena_scratch_end(scratch);
+
+	grad.rows = rows;
+	grad.values = values;
+	grad.n_rows = unique;
+
+	return grad;
+
+}
@@ -0,0 +1,99 @@
+#include <string.h>
+#include "../../include/pipeline/im2col.h"
+
+int window_out(int size, int kernel, int stride, int padding){
+
+	return (size + 2 * padding - kernel) / stride + 1;
+
+}
+
+// Row (c, ki, kj) of cols holds, for every output position, the image value
+// under kernel tap (ki, kj) of channel c; taps over the padding read 0.
+void im2col(double *cols, double *image, Window2d *w){
+
+	int k = w->kernel;
+	int oh = window_out(w->height, k, w->stride, w->padding);
+	int ow = window_out(w->width, k, w->stride, w->padding);
+
+	for (int c = 0; c < w->channels; c++){
+
+		double *plane = image + (size_t)c * w->height * w->width;
+
+		for (int ki = 0; ki < k; ki++){
+
+			for (int kj = 0; kj < k; kj++){
+
+				double *row = cols + ((size_t)(c * k + ki) * k + kj) * oh * ow;
+
+				for (int y = 0; y < oh; y++){
+
+					int iy = y * w->stride - w->padding + ki;
+					double *out = row + (size_t)y * ow;
+
+					if (iy < 0 || iy >= w->height){
+
+						memset(out, 0, ow * sizeof(double));
+						continue;
+
+					}
+
+					double *src = plane + (size_t)iy * w->width;
+
+					for (int x = 0; x < ow; x++){
+
+						int ix = x * w->stride - w->padding + kj;
+						out[x] = ix >= 0 && ix < w->width ? src[ix] : 0.0;
+
+					}
+
+				}
+
+			}
+
+		}
+
+	}
+
+}
+
+// adds every column entry back onto the pixel it was read from
+void col2im(double *image, double *cols, Window2d *w){
+
+	int k = w->kernel;
+	int oh = window_out(w->height, k, w->stride, w->padding);
+	int ow = window_out(w->width, k, w->stride, w->padding);
+
+	for (int c = 0; c < w->channels; c++){
+
+		double *plane = image + (size_t)c * w->height * w->width;
+
+		for (int ki = 0; ki < k; ki++){
+
+			for (int kj = 0; kj < k; kj++){
+
+				double *row = cols + ((size_t)(c * k + ki) * k + kj) * oh * ow;
+
+				for (int y = 0; y < oh; y++){
+
+					int iy = y * w->stride - w->padding + ki;
+					if (iy < 0 || iy >= w->height) continue;
+
+					double *dst = plane + (size_t)iy * w->width;
+					double *in = row + (size_t)y * ow;
+
+					for (int x = 0; x < ow; x++){
+
+						int ix = x * w->stride - w->padding + kj;
+						if (ix >= 0 && ix < w->width) dst[ix] += in[x];
+
+					}
+
+				}
+
+			}
+
+		}
+
+	}
+
+}
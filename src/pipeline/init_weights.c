@@ -1,19 +1,45 @@
 #include <stdlib.h>
-#include <string.h>
+#include <math.h>
 #include "../../include/pipeline/init_weights.h"
-#include "../../include/arena.h"
-#include "../../include/random/random_normal.h"
+#include "../../include/random/ziggurat.h"
 
-double *init_weights(int n, double mean, double std){
+// std of N(0, 1) truncated to [-2, 2]; dividing by it restores the
+// requested variance after truncation
+#define TRUNCATED_STD 0.87962566103423978
 
-	Arena *tmp = arena_create(n * sizeof(double) + 256);
-	double *rnd = random_normal(tmp, mean, std, n);
+double *init_weights(int n, double mean, double std){
 
 	double *weights = malloc(n * sizeof(double));
-	memcpy(weights, rnd, n * sizeof(double));
+	if (!weights) return NULL;
 
-	arena_destroy(tmp);
+	rng_fill_normal(rng_default(), weights, n, mean, std);
 
 	return weights;
 
 }
+
+// Xavier keeps the variance of activations and gradients balanced with
+// Var = 2 / (fan_in + fan_out); He uses 2 / fan_in to make up for the half
+// of the units ReLU zeroes. Uniform variants draw from [-a, a] with
+// a = sqrt(3 Var); normal variants from a normal truncated at two standard
+// deviations and rescaled to the same variance.
+void init_fill(Rng *rng, double *weights, int fan_in, int fan_out, InitScheme scheme){
+
+	if (!rng) rng = rng_default();
+
+	size_t n = (size_t)fan_in * fan_out;
+	int he = scheme == INIT_HE_UNIFORM || scheme == INIT_HE_NORMAL;
+	double var = he ? 2.0 / fan_in : 2.0 / (fan_in + fan_out);
+
+	if (scheme == INIT_XAVIER_UNIFORM || scheme == INIT_HE_UNIFORM){
+
+		double a = sqrt(3.0 * var);
+		rng_fill_uniform(rng, weights, n, -a, a);
+		return;
+
+	}
+
+	double std = sqrt(var) / TRUNCATED_STD;
+	rng_fill_truncated_normal(rng, weights, n, 0.0, std, -2.0 * std, 2.0 * std);
+
+}
@@ -0,0 +1,303 @@
+#include <math.h>
+#include <string.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "../../include/pipeline/layer_norm.h"
+
+typedef struct {
+	double *input;
+	double *dout;
+	double *gamma;
+	double *beta;
+	double *out;
+	double *mean;
+	double *rstd;
+	double *partial;
+	int n;
+	double eps;
+	int rms;
+} NormJob;
+
+typedef void (*RowFn)(NormJob *job, int begin, int end);
+
+// each task works on its own copy of the job so per-worker outputs
+// (the backward partial sums) can be pointed at that worker's slice
+typedef struct {
+	RowFn fn;
+	NormJob job;
+	int begin;
+	int end;
+} RowTask;
+
+static void *row_task_main(void *arg){
+
+	RowTask *task = arg;
+	task->fn(&task->job, task->begin, task->end);
+
+	return NULL;
+
+}
+
+// Rows are independent, so large matrices are split into contiguous row
+// ranges, one per thread. Below NORM_PARALLEL_MIN elements the cost of
+// starting threads outweighs the work and everything stays on the caller.
+static int norm_threads(int m, int n){
+
+	if ((size_t)m * n < NORM_PARALLEL_MIN) return 1;
+
+	long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	int threads = cpus < 1 ? 1 : cpus > NORM_MAX_THREADS ? NORM_MAX_THREADS : (int)cpus;
+
+	return threads > m ? m : threads;
+
+}
+
+static void parallel_rows(RowFn fn, NormJob *job, int m, int threads){
+
+	pthread_t ids[NORM_MAX_THREADS];
+	RowTask tasks[NORM_MAX_THREADS];
+	int started[NORM_MAX_THREADS];
+
+	for (int w = 0; w < threads; w++){
+
+		tasks[w].fn = fn;
+		tasks[w].job = *job;
+		tasks[w].begin = (int)((long long)m * w / threads);
+		tasks[w].end = (int)((long long)m * (w + 1) / threads);
+
+		if (job->partial)
+			tasks[w].job.partial = job->partial + (size_t)w * 2 * job->n;
+
+		// a worker that fails to start runs on the calling thread instead
+		started[w] = w > 0 && pthread_create(&ids[w], NULL, row_task_main, &tasks[w]) == 0;
+
+	}
+
+	for (int w = 0; w < threads; w++)
+		if (!started[w]) row_task_main(&tasks[w]);
+
+	for (int w = 1; w < threads; w++)
+		if (started[w]) pthread_join(ids[w], NULL);
+
+}
+
+// One read pass per row gathers the statistics (Welford for layer norm,
+// the mean square for RMS norm), one write pass applies them.
+static void forward_rows(NormJob *job, int begin, int end){
+
+	int n = job->n;
+
+	for (int i = begin; i < end; i++){
+
+		double *x = job->input + (size_t)i * n;
+		double *y = job->out + (size_t)i * n;
+		double mean = 0.0;
+		double m2 = 0.0;
+
+		if (job->rms){
+
+			for (int j = 0; j < n; j++) m2 += x[j] * x[j];
+
+		} else {
+
+			for (int j = 0; j < n; j++){
+
+				double delta = x[j] - mean;
+				mean += delta / (j + 1);
+				m2 += delta * (x[j] - mean);
+
+			}
+
+		}
+
+		double rstd = 1.0 / sqrt(m2 / n + job->eps);
+
+		if (job->beta){
+
+			for (int j = 0; j < n; j++)
+				y[j] = (x[j] - mean) * rstd * job->gamma[j] + job->beta[j];
+
+		} else {
+
+			for (int j = 0; j < n; j++)
+				y[j] = (x[j] - mean) * rstd * job->gamma[j];
+
+		}
+
+		if (job->mean) job->mean[i] = mean;
+		if (job->rstd) job->rstd[i] = rstd;
+
+	}
+
+}
+
+// With x_hat = (x - mean) * rstd and g = dout * gamma:
+//   d_input = rstd * (g - mean(g) - x_hat * mean(g * x_hat))
+// where RMS norm has mean = 0 and drops the mean(g) term. The two row
+// means come from one read pass and d_input from one write pass; column
+// sums for d_gamma and d_beta go to this worker's slice of job->partial.
+static void backward_rows(NormJob *job, int begin, int end){
+
+	int n = job->n;
+	double *dg = job->partial;
+	double *db = dg + n;
+
+	memset(dg, 0, 2 * (size_t)n * sizeof(double));
+
+	for (int i = begin; i < end; i++){
+
+		double *x = job->input + (size_t)i * n;
+		double *dy = job->dout + (size_t)i * n;
+		double *dx = job->out + (size_t)i * n;
+		double mean = job->rms ? 0.0 : job->mean[i];
+		double rstd = job->rstd[i];
+		double sum_g = 0.0;
+		double sum_gx = 0.0;
+
+		for (int j = 0; j < n; j++){
+
+			double x_hat = (x[j] - mean) * rstd;
+			double g = dy[j] * job->gamma[j];
+
+			sum_g += g;
+			sum_gx += g * x_hat;
+			dg[j] += dy[j] * x_hat;
+			db[j] += dy[j];
+
+		}
+
+		double mean_g = job->rms ? 0.0 : sum_g / n;
+		double mean_gx = sum_gx / n;
+
+		for (int j = 0; j < n; j++){
+
+			double x_hat = (x[j] - mean) * rstd;
+			dx[j] = rstd * (dy[j] * job->gamma[j] - mean_g - x_hat * mean_gx);
+
+		}
+
+	}
+
+}
+
+static double *norm_forward(Arena *arena, NormJob *job, int m, NormCache *cache){
+
+	int n = job->n;
+
+	job->out = arena_push(arena, (size_t)m * n * sizeof(double));
+	if (!job->out) return NULL;
+
+	if (cache){
+
+		job->mean = job->rms ? NULL : arena_push(arena, m * sizeof(double));
+		job->rstd = arena_push(arena, m * sizeof(double));
+		if ((!job->rms && !job->mean) || !job->rstd) return NULL;
+
+		cache->mean = job->mean;
+		cache->rstd = job->rstd;
+
+	}
+
+	parallel_rows(forward_rows, job, m, norm_threads(m, n));
+
+	return job->out;
+
+}
+
+static double *norm_backward(Arena *arena, NormJob *job, int m, double *d_gamma, double *d_beta){
+
+	int n = job->n;
+	int threads = norm_threads(m, n);
+
+	job->out = arena_push(arena, (size_t)m * n * sizeof(double));
+	if (!job->out) return NULL;
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	job->partial = arena_push(scratch.arena, (size_t)threads * 2 * n * sizeof(double));
+	if (!job->partial){
+
+		arena_scratch_end(scratch);
+		return NULL;
+
+	}
+
+	parallel_rows(backward_rows, job, m, threads);
+
+	for (int j = 0; j < n; j++){
+
+		double dg = 0.0;
+		double db = 0.0;
+
+		for (int w = 0; w < threads; w++){
+
+			dg += job->partial[(size_t)w * 2 * n + j];
+			db += job->partial[(size_t)w * 2 * n + n + j];
+
+		}
+
+		d_gamma[j] = dg;
+		if (d_beta) d_beta[j] = db;
+
+	}
+
+	arena_scratch_end(scratch);
+
+	return job->out;
+
+}
+
+double *layer_norm_forward(Arena *arena, double *input, double *gamma, double *beta, int m, int n, double eps, NormCache *cache){
+
+	NormJob job = {0};
+	job.input = input;
+	job.gamma = gamma;
+	job.beta = beta;
+	job.n = n;
+	job.eps = eps;
+
+	return norm_forward(arena, &job, m, cache);
+
+}
+
+double *layer_norm_backward(Arena *arena, double *dout, double *input, double *gamma, NormCache *cache, int m, int n, double *d_gamma, double *d_beta){
+
+	NormJob job = {0};
+	job.input = input;
+	job.dout = dout;
+	job.gamma = gamma;
+	job.mean = cache->mean;
+	job.rstd = cache->rstd;
+	job.n = n;
+
+	return norm_backward(arena, &job, m, d_gamma, d_beta);
+
+}
+
+double *rms_norm_forward(Arena *arena, double *input, double *gamma, int m, int n, double eps, NormCache *cache){
+
+	NormJob job = {0};
+	job.input = input;
+	job.gamma = gamma;
+	job.n = n;
+	job.eps = eps;
+	job.rms = 1;
+
+	return norm_forward(arena, &job, m, cache);
+
+}
+
+double *rms_norm_backward(Arena *arena, double *dout, double *input, double *gamma, NormCache *cache, int m, int n, double *d_gamma){
+
+	NormJob job = {0};
+	job.input = input;
+	job.dout = dout;
+	job.gamma = gamma;
+	job.rstd = cache->rstd;
+	job.n = n;
+	job.rms = 1;
+
+	return norm_backward(arena, &job, m, d_gamma, NULL);
+
+}
@@ -0,0 +1,189 @@
+#include <string.h>
+#include <float.h>
+#include "../../include/pipeline/pool2d.h"
+#include "../../include/pipeline/im2col.h"
+
+// argmax[o] is the offset of the winning pixel within its sample, so the
+// backward pass is a single scatter
+double *max_pool2d_forward(Arena *arena, double *input, int m, Window2d *shape, int **argmax){
+
+	int k = shape->kernel;
+	int h = shape->height;
+	int w = shape->width;
+	int oh = window_out(h, k, shape->stride, shape->padding);
+	int ow = window_out(w, k, shape->stride, shape->padding);
+	size_t in_size = (size_t)shape->channels * h * w;
+	size_t out_size = (size_t)shape->channels * oh * ow;
+
+	double *out = arena_push(arena, m * out_size * sizeof(double));
+	int *idx = argmax ? arena_push(arena, m * out_size * sizeof(int)) : NULL;
+	if (!out || (argmax && !idx)) return NULL;
+
+	for (int s = 0; s < m; s++){
+
+		for (int c = 0; c < shape->channels; c++){
+
+			double *plane = input + s * in_size + (size_t)c * h * w;
+			size_t o = s * out_size + (size_t)c * oh * ow;
+
+			for (int y = 0; y < oh; y++){
+
+				for (int x = 0; x < ow; x++, o++){
+
+					int y0 = y * shape->stride - shape->padding;
+					int x0 = x * shape->stride - shape->padding;
+					double best = -DBL_MAX;
+					int best_at = -1;
+
+					for (int iy = y0 < 0 ? 0 : y0; iy < y0 + k && iy < h; iy++){
+
+						for (int ix = x0 < 0 ? 0 : x0; ix < x0 + k && ix < w; ix++){
+
+							if (best_at < 0 || plane[iy * w + ix] > best){
+
+								best = plane[iy * w + ix];
+								best_at = iy * w + ix;
+
+							}
+
+						}
+
+					}
+
+					out[o] = best_at < 0 ? 0.0 : best;
+					if (idx) idx[o] = best_at < 0 ? -1 : c * h * w + best_at;
+
+				}
+
+			}
+
+		}
+
+	}
+
+	if (argmax) *argmax = idx;
+
+	return out;
+
+}
+
+double *max_pool2d_backward(Arena *arena, double *dout, int *argmax, int m, Window2d *shape){
+
+	int oh = window_out(shape->height, shape->kernel, shape->stride, shape->padding);
+	int ow = window_out(shape->width, shape->kernel, shape->stride, shape->padding);
+	size_t in_size = (size_t)shape->channels * shape->height * shape->width;
+	size_t out_size = (size_t)shape->channels * oh * ow;
+
+	double *d_input = arena_push(arena, m * in_size * sizeof(double));
+	if (!d_input) return NULL;
+
+	memset(d_input, 0, m * in_size * sizeof(double));
+
+	for (int s = 0; s < m; s++){
+
+		double *d = d_input + s * in_size;
+		size_t base = s * out_size;
+
+		for (size_t o = 0; o < out_size; o++)
+			if (argmax[base + o] >= 0) d[argmax[base + o]] += dout[base + o];
+
+	}
+
+	return d_input;
+
+}
+
+// padded taps count as zeros, so every window divides by kernel * kernel
+double *avg_pool2d_forward(Arena *arena, double *input, int m, Window2d *shape){
+
+	int k = shape->kernel;
+	int h = shape->height;
+	int w = shape->width;
+	int oh = window_out(h, k, shape->stride, shape->padding);
+	int ow = window_out(w, k, shape->stride, shape->padding);
+	size_t in_size = (size_t)shape->channels * h * w;
+	size_t out_size = (size_t)shape->channels * oh * ow;
+	double inv = 1.0 / (k * k);
+
+	double *out = arena_push(arena, m * out_size * sizeof(double));
+	if (!out) return NULL;
+
+	for (int s = 0; s < m; s++){
+
+		for (int c = 0; c < shape->channels; c++){
+
+			double *plane = input + s * in_size + (size_t)c * h * w;
+			double *o = out + s * out_size + (size_t)c * oh * ow;
+
+			for (int y = 0; y < oh; y++){
+
+				for (int x = 0; x < ow; x++){
+
+					int y0 = y * shape->stride - shape->padding;
+					int x0 = x * shape->stride - shape->padding;
+					double sum = 0.0;
+
+					for (int iy = y0 < 0 ? 0 : y0; iy < y0 + k && iy < h; iy++)
+						for (int ix = x0 < 0 ? 0 : x0; ix < x0 + k && ix < w; ix++)
+							sum += plane[iy * w + ix];
+
+					o[y * ow + x] = sum * inv;
+
+				}
+
+			}
+
+		}
+
+	}
+
+	return out;
+
+}
+
+double *avg_pool2d_backward(Arena *arena, double *dout, int m, Window2d *shape){
+
+	int k = shape->kernel;
+	int h = shape->height;
+	int w = shape->width;
+	int oh = window_out(h, k, shape->stride, shape->padding);
+	int ow = window_out(w, k, shape->stride, shape->padding);
+	size_t in_size = (size_t)shape->channels * h * w;
+	size_t out_size = (size_t)shape->channels * oh * ow;
+	double inv = 1.0 / (k * k);
+
+	double *d_input = arena_push(arena, m * in_size * sizeof(double));
+	if (!d_input) return NULL;
+
+	memset(d_input, 0, m * in_size * sizeof(double));
+
+	for (int s = 0; s < m; s++){
+
+		for (int c = 0; c < shape->channels; c++){
+
+			double *plane = d_input + s * in_size + (size_t)c * h * w;
+			double *d = dout + s * out_size + (size_t)c * oh * ow;
+
+			for (int y = 0; y < oh; y++){
+
+				for (int x = 0; x < ow; x++){
+
+					int y0 = y * shape->stride - shape->padding;
+					int x0 = x * shape->stride - shape->padding;
+					double g = d[y * ow + x] * inv;
+
+					for (int iy = y0 < 0 ? 0 : y0; iy < y0 + k && iy < h; iy++)
+						for (int ix = x0 < 0 ? 0 : x0; ix < x0 + k && ix < w; ix++)
+							plane[iy * w + ix] += g;
+
+				}
+
+			}
+
+		}
+
+	}
+
+	return d_input;
+
+}
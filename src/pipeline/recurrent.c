@@ -0,0 +1,323 @@
+#include <math.h>
+#include <string.h>
+#include "../../include/pipeline/recurrent.h"
+#include "../../include/activations/sigmoid.h"
+#include "../../include/linalg/matricies/gemm.h"
+
+void recurrent_init(RecurrentLayer *rnn, CellType cell, double *params, int n_in, int hidden){
+
+	int gh = RECURRENT_GATES(cell) * hidden;
+
+	rnn->cell = cell;
+	rnn->n_in = n_in;
+	rnn->hidden = hidden;
+	rnn->w_x = params;
+	rnn->w_h = params + (size_t)n_in * gh;
+	rnn->bias = params + (size_t)(n_in + hidden) * gh;
+
+	// the LSTM forget gate starts open so early gradients reach back in time
+	for (int j = 0; j < gh; j++)
+		rnn->bias[j] = (cell == CELL_LSTM && j >= hidden && j < 2 * hidden) ? 1.0 : 0.0;
+
+}
+
+// One pass over the packed pre-activations of a step: every gate's
+// nonlinearity, the cell update and the new hidden state, with the
+// activated gates written back over their pre-activations.
+static void lstm_cell(double *a, double *c, double *c_prev, double *h, int m, int H){
+
+	for (int r = 0; r < m; r++){
+
+		double *ai = a + (size_t)r * 4 * H;
+		double *af = ai + H;
+		double *ag = ai + 2 * H;
+		double *ao = ai + 3 * H;
+		double *cr = c + (size_t)r * H;
+		double *cp = c_prev ? c_prev + (size_t)r * H : NULL;
+		double *hr = h + (size_t)r * H;
+
+		for (int j = 0; j < H; j++){
+
+			double i = sigmoid(ai[j]);
+			double f = sigmoid(af[j]);
+			double g = tanh(ag[j]);
+			double o = sigmoid(ao[j]);
+			double cj = i * g + (cp ? f * cp[j] : 0.0);
+
+			ai[j] = i;
+			af[j] = f;
+			ag[j] = g;
+			ao[j] = o;
+			cr[j] = cj;
+			hr[j] = o * tanh(cj);
+
+		}
+
+	}
+
+}
+
+// hp is h_prev W_h; its candidate block is gated by r before the tanh, so
+// it is kept apart from the input projection in a and stored in hn.
+static void gru_cell(double *a, double *hp, double *hn, double *h_prev, double *h, int m, int H){
+
+	for (int r = 0; r < m; r++){
+
+		double *az = a + (size_t)r * 3 * H;
+		double *ar = az + H;
+		double *an = az + 2 * H;
+		double *pz = hp ? hp + (size_t)r * 3 * H : NULL;
+		double *hr = h + (size_t)r * H;
+
+		for (int j = 0; j < H; j++){
+
+			double z = sigmoid(az[j] + (pz ? pz[j] : 0.0));
+			double rg = sigmoid(ar[j] + (pz ? pz[H + j] : 0.0));
+			double hnj = pz ? pz[2 * H + j] : 0.0;
+			double n = tanh(an[j] + rg * hnj);
+			double prev = h_prev ? h_prev[(size_t)r * H + j] : 0.0;
+
+			az[j] = z;
+			ar[j] = rg;
+			an[j] = n;
+			if (hn) hn[(size_t)r * H + j] = hnj;
+			hr[j] = (1.0 - z) * n + z * prev;
+
+		}
+
+	}
+
+}
+
+// Input is time-major (steps x m x n_in). The input projection of every
+// step is one GEMM up front; each step then costs one GEMM with the packed
+// recurrent weights and one fused gate pass. The initial state is zero.
+double *recurrent_forward(Arena *arena, RecurrentLayer *rnn, double *input, int steps, int m, RecurrentCache *cache){
+
+	int H = rnn->hidden;
+	int gh = RECURRENT_GATES(rnn->cell) * H;
+	int lstm = rnn->cell == CELL_LSTM;
+	size_t rows = (size_t)steps * m;
+	size_t step_gates = (size_t)m * gh;
+	size_t step_h = (size_t)m * H;
+
+	double *out = arena_push(arena, rows * H * sizeof(double));
+	double *gates = cache ? arena_push(arena, rows * gh * sizeof(double)) : NULL;
+	double *state = cache ? arena_push(arena, rows * H * sizeof(double)) : NULL;
+	if (!out || (cache && (!gates || !state))) return NULL;
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return NULL;
+
+	// without a cache the gates live on scratch and only the current cell
+	// state is kept
+	if (!cache){
+
+		gates = arena_push(scratch.arena, rows * gh * sizeof(double));
+		state = lstm ? arena_push(scratch.arena, step_h * sizeof(double)) : NULL;
+
+	}
+
+	double *hp = lstm ? NULL : arena_push(scratch.arena, step_gates * sizeof(double));
+	if (!gates || (lstm && !state) || (!lstm && !hp)){
+
+		arena_scratch_end(scratch);
+		return NULL;
+
+	}
+
+	for (size_t i = 0; i < rows; i++)
+		memcpy(gates + i * gh, rnn->bias, gh * sizeof(double));
+
+	gemm(gates, input, rnn->w_x, (int)rows, rnn->n_in, gh, 0, 0, 1.0, 1.0);
+
+	for (int t = 0; t < steps; t++){
+
+		double *a = gates + t * step_gates;
+		double *h = out + t * step_h;
+		double *h_prev = t ? h - step_h : NULL;
+		double *s = cache ? state + t * step_h : state;
+
+		if (lstm){
+
+			double *s_prev = !t ? NULL : cache ? s - step_h : s;
+
+			if (h_prev) gemm(a, h_prev, rnn->w_h, m, H, gh, 0, 0, 1.0, 1.0);
+			lstm_cell(a, s, s_prev, h, m, H);
+
+		} else {
+
+			if (h_prev) gemm(hp, h_prev, rnn->w_h, m, H, gh, 0, 0, 1.0, 0.0);
+			gru_cell(a, h_prev ? hp : NULL, s, h_prev, h, m, H);
+
+		}
+
+	}
+
+	arena_scratch_end(scratch);
+
+	if (cache){
+
+		cache->gates = gates;
+		cache->state = state;
+
+	}
+
+	return out;
+
+}
+
+// dh carries the gradient flowing into h from the next step and dc the
+// one into c; dc is replaced by the gradient into c_prev.
+static void lstm_cell_backward(double *dp, double *dh, double *dc, double *a, double *c, double *c_prev, double *dout, int m, int H){
+
+	for (int r = 0; r < m; r++){
+
+		double *ai = a + (size_t)r * 4 * H;
+		double *di = dp + (size_t)r * 4 * H;
+		size_t row = (size_t)r * H;
+
+		for (int j = 0; j < H; j++){
+
+			double i = ai[j];
+			double f = ai[H + j];
+			double g = ai[2 * H + j];
+			double o = ai[3 * H + j];
+			double tc = tanh(c[row + j]);
+			double cp = c_prev ? c_prev[row + j] : 0.0;
+
+			double dhj = dout[row + j] + dh[row + j];
+			double dcj = dc[row + j] + dhj * o * (1.0 - tc * tc);
+
+			di[j] = dcj * g * i * (1.0 - i);
+			di[H + j] = dcj * cp * f * (1.0 - f);
+			di[2 * H + j] = dcj * i * (1.0 - g * g);
+			di[3 * H + j] = dhj * tc * o * (1.0 - o);
+			dc[row + j] = dcj * f;
+
+		}
+
+	}
+
+}
+
+// dp is the gradient of the input projection and dph that of h_prev W_h;
+// they differ only in the candidate block, where dph carries the reset
+// gate. dh is replaced by the direct z * dh path into h_prev.
+static void gru_cell_backward(double *dp, double *dph, double *dh, double *a, double *hn, double *h_prev, double *dout, int m, int H){
+
+	for (int r = 0; r < m; r++){
+
+		double *az = a + (size_t)r * 3 * H;
+		double *dz = dp + (size_t)r * 3 * H;
+		double *dhz = dph + (size_t)r * 3 * H;
+		size_t row = (size_t)r * H;
+
+		for (int j = 0; j < H; j++){
+
+			double z = az[j];
+			double rg = az[H + j];
+			double n = az[2 * H + j];
+			double prev = h_prev ? h_prev[row + j] : 0.0;
+
+			double dhj = dout[row + j] + dh[row + j];
+			double dn = dhj * (1.0 - z) * (1.0 - n * n);
+			double dzj = dhj * (prev - n) * z * (1.0 - z);
+			double drj = dn * hn[row + j] * rg * (1.0 - rg);
+
+			dz[j] = dzj;
+			dz[H + j] = drj;
+			dz[2 * H + j] = dn;
+			dhz[j] = dzj;
+			dhz[H + j] = drj;
+			dhz[2 * H + j] = dn * rg;
+			dh[row + j] = dhj * z;
+
+		}
+
+	}
+
+}
+
+// Backpropagation through time. dout is the gradient of every step's
+// hidden output. The gate gradients of all steps are kept so that, as in
+// the forward pass, the input-side weight and input gradients are each a
+// single GEMM over the whole sequence after the loop.
+RecurrentGrad recurrent_backward(Arena *arena, RecurrentLayer *rnn, double *dout, double *input, double *output, RecurrentCache *cache, int steps, int m){
+
+	RecurrentGrad grad = {NULL, NULL, NULL, NULL};
+
+	int H = rnn->hidden;
+	int n_in = rnn->n_in;
+	int gh = RECURRENT_GATES(rnn->cell) * H;
+	int lstm = rnn->cell == CELL_LSTM;
+	size_t rows = (size_t)steps * m;
+	size_t step_gates = (size_t)m * gh;
+	size_t step_h = (size_t)m * H;
+
+	double *d_w_x = arena_push(arena, (size_t)n_in * gh * sizeof(double));
+	double *d_w_h = arena_push(arena, (size_t)H * gh * sizeof(double));
+	double *d_bias = arena_push(arena, gh * sizeof(double));
+	double *d_input = arena_push(arena, rows * n_in * sizeof(double));
+	if (!d_w_x || !d_w_h || !d_bias || !d_input) return grad;
+
+	memset(d_w_h, 0, (size_t)H * gh * sizeof(double));
+	memset(d_bias, 0, gh * sizeof(double));
+
+	ArenaTemp scratch = arena_scratch_begin(&arena, 1);
+	if (!scratch.arena) return grad;
+
+	double *dpre = arena_push(scratch.arena, rows * gh * sizeof(double));
+	double *dh = arena_push(scratch.arena, 2 * step_h * sizeof(double));
+	double *dph = lstm ? NULL : arena_push(scratch.arena, step_gates * sizeof(double));
+	if (!dpre || !dh || (!lstm && !dph)){
+
+		arena_scratch_end(scratch);
+		return grad;
+
+	}
+
+	double *dc = dh + step_h;
+	memset(dh, 0, 2 * step_h * sizeof(double));
+
+	for (int t = steps - 1; t >= 0; t--){
+
+		double *a = cache->gates + t * step_gates;
+		double *s = cache->state + t * step_h;
+		double *dp = dpre + t * step_gates;
+		double *h_prev = t ? output + (t - 1) * step_h : NULL;
+		double *d = dout + t * step_h;
+
+		if (lstm){
+
+			lstm_cell_backward(dp, dh, dc, a, s, t ? s - step_h : NULL, d, m, H);
+			if (t) gemm(d_w_h, h_prev, dp, H, m, gh, 1, 0, 1.0, 1.0);
+			if (t) gemm(dh, dp, rnn->w_h, m, gh, H, 0, 1, 1.0, 0.0);
+
+		} else {
+
+			gru_cell_backward(dp, dph, dh, a, s, h_prev, d, m, H);
+			if (t) gemm(d_w_h, h_prev, dph, H, m, gh, 1, 0, 1.0, 1.0);
+			if (t) gemm(dh, dph, rnn->w_h, m, gh, H, 0, 1, 1.0, 1.0);
+
+		}
+
+	}
+
+	gemm(d_w_x, input, dpre, n_in, (int)rows, gh, 1, 0, 1.0, 0.0);
+	gemm(d_input, dpre, rnn->w_x, (int)rows, gh, n_in, 0, 1, 1.0, 0.0);
+
+	for (size_t i = 0; i < rows; i++)
+		for (int j = 0; j < gh; j++)
+			d_bias[j] += dpre[i * gh + j];
+
+	arena_scratch_end(scratch);
+
+	grad.d_w_x = d_w_x;
+	grad.d_w_h = d_w_h;
+	grad.d_bias = d_bias;
+	grad.d_input = d_input;
+
+	return grad;
+
+}
@@ -0,0 +1,60 @@
+#include "../../include/random/philox.h"
+
+#define PHILOX_M0 0xD2511F53u
+#define PHILOX_M1 0xCD9E8D57u
+#define PHILOX_W0 0x9E3779B9u
+#define PHILOX_W1 0xBB67AE85u
+
+// Philox4x32-10 (Salmon et al., "Parallel random numbers: as easy as
+// 1, 2, 3"): a keyed bijection of the 128-bit counter, so any block of the
+// stream can be computed on its own, in any order, on any thread
+void philox4x32(u32 out[4], const u32 counter[4], const u32 key[2]){
+
+	u32 c0 = counter[0], c1 = counter[1], c2 = counter[2], c3 = counter[3];
+	u32 k0 = key[0], k1 = key[1];
+
+	for (int r = 0; r < PHILOX_ROUNDS; r++){
+
+		u64 p0 = (u64)PHILOX_M0 * c0;
+		u64 p1 = (u64)PHILOX_M1 * c2;
+
+		u32 n0 = (u32)(p1 >> 32) ^ c1 ^ k0;
+		u32 n2 = (u32)(p0 >> 32) ^ c3 ^ k1;
+
+		c0 = n0;
+		c1 = (u32)p1;
+		c2 = n2;
+		c3 = (u32)p0;
+
+		k0 += PHILOX_W0;
+		k1 += PHILOX_W1;
+
+	}
+
+	out[0] = c0;
+	out[1] = c1;
+	out[2] = c2;
+	out[3] = c3;
+
+}
+
+// block b of stream s under seed k is philox4x32({b, s}, k); n need not be
+// a multiple of 4, the last block is cut short
+void philox_fill(u32 *out, u64 n, u64 seed, u64 stream, u64 first_block){
+
+	u32 key[2] = {(u32)seed, (u32)(seed >> 32)};
+	u32 block[4];
+
+	for (u64 i = 0; i < n; i += 4){
+
+		u64 b = first_block + i / 4;
+		u32 counter[4] = {(u32)b, (u32)(b >> 32), (u32)stream, (u32)(stream >> 32)};
+
+		philox4x32(block, counter, key);
+
+		for (u64 j = 0; j < 4 && i + j < n; j++)
+			out[i + j] = block[j];
+
+	}
+
+}
@@ -1,8 +1,8 @@
-#include <stdlib.h>
 #include "../../include/random/random_seed.h"
+#include "../../include/random/rng.h"
 
 void random_seed(unsigned int seed){
 
-	srand(seed);
+	rng_seed(rng_default(), RNG_XOSHIRO, seed);
 
 }
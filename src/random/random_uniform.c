@@ -1,15 +1,12 @@
-#include <stdlib.h>
 #include "../../include/random/random_uniform.h"
+#include "../../include/random/rng.h"
 
 double *random_uniform(Arena *arena, double min, double max, int n){
 
 	double *result = arena_push(arena, n*sizeof(double));
+	if (!result) return NULL;
 
-	for (int i = 0; i < n; i++){
-
-		result[i] = min + (max - min) * ((double)rand() / RAND_MAX);
-
-	}
+	rng_fill_uniform(rng_default(), result, n, min, max);
 
 	return result;
 
@@ -0,0 +1,263 @@
+#include <string.h>
+#include "../../include/random/rng.h"
+#include "../../include/random/philox.h"
+
+#define FLOAT_ONE 0x3F800000u
+
+static Rng default_rng;
+static int default_ready = 0;
+
+static inline u64 rotl(u64 x, int k){
+
+	return (x << k) | (x >> (64 - k));
+
+}
+
+static u64 splitmix64(u64 *x){
+
+	u64 z = (*x += 0x9E3779B97F4A7C15ull);
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+
+	return z ^ (z >> 31);
+
+}
+
+// xoshiro256** (Blackman and Vigna) is seeded through splitmix64 so that
+// nearby seeds still give unrelated, never all-zero states. Philox takes
+// the seed as its key and starts at block 0 of stream 0.
+void rng_seed(Rng *rng, RngKind kind, u64 seed){
+
+	rng->kind = kind;
+	rng->used = 4;
+
+	if (kind == RNG_PHILOX){
+
+		rng->s[0] = seed;
+		rng->s[1] = 0;
+		rng->s[2] = 0;
+		rng->s[3] = 0;
+		return;
+
+	}
+
+	u64 x = seed;
+	for (int i = 0; i < 4; i++)
+		rng->s[i] = splitmix64(&x);
+
+}
+
+// Advances xoshiro by 2^128 draws, or moves Philox to the next stream.
+// Either way the result is a sequence that will not overlap the old one,
+// so n threads can take the streams left by 1..n jumps of one seed.
+void rng_jump(Rng *rng){
+
+	static const u64 jump[4] = {0x180EC6D33CFD0ABAull, 0xD5A61266F0C9392Cull, 0xA9582618E03FC9AAull, 0x39ABDC4529B1661Cull};
+
+	if (rng->kind == RNG_PHILOX){
+
+		rng->s[1]++;
+		rng->s[2] = 0;
+		rng->used = 4;
+		return;
+
+	}
+
+	u64 acc[4] = {0, 0, 0, 0};
+
+	for (int w = 0; w < 4; w++){
+		for (int b = 0; b < 64; b++){
+
+			if (jump[w] & (1ull << b))
+				for (int i = 0; i < 4; i++) acc[i] ^= rng->s[i];
+
+			rng_next(rng);
+
+		}
+	}
+
+	memcpy(rng->s, acc, sizeof(acc));
+
+}
+
+static inline u64 xoshiro_next(u64 *s){
+
+	u64 result = rotl(s[1] * 5, 7) * 9;
+	u64 t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = rotl(s[3], 45);
+
+	return result;
+
+}
+
+static void philox_refill(Rng *rng){
+
+	philox_fill(rng->block, 4, rng->s[0], rng->s[1], rng->s[2]++);
+	rng->used = 0;
+
+}
+
+// a Philox draw is two consecutive words of the block, low word first
+u64 rng_next(Rng *rng){
+
+	if (rng->kind == RNG_XOSHIRO) return xoshiro_next(rng->s);
+
+	if (rng->used >= 4) philox_refill(rng);
+
+	u64 lo = rng->block[rng->used];
+	u64 hi = rng->block[rng->used + 1];
+	rng->used += 2;
+
+	return lo | (hi << 32);
+
+}
+
+// full 64x64 -> 128 bit product from four 32-bit partial products, returns the
+// high word and stores the low one (C99 has no 128-bit integer)
+static inline u64 mul_64x64(u64 a, u64 b, u64 *low){
+
+	u64 a_lo = a & 0xffffffffu, a_hi = a >> 32;
+	u64 b_lo = b & 0xffffffffu, b_hi = b >> 32;
+
+	u64 lo_lo = a_lo * b_lo;
+	u64 hi_lo = a_hi * b_lo;
+	u64 lo_hi = a_lo * b_hi;
+	u64 hi_hi = a_hi * b_hi;
+
+	u64 cross = (lo_lo >> 32) + (hi_lo & 0xffffffffu) + lo_hi;
+	*low = (cross << 32) | (lo_lo & 0xffffffffu);
+
+	return hi_hi + (hi_lo >> 32) + (cross >> 32);
+
+}
+
+// Lemire's multiply-shift with rejection: unbiased and almost never loops
+u64 rng_below(Rng *rng, u64 bound){
+
+	u64 low;
+	u64 high = mul_64x64(rng_next(rng), bound, &low);
+
+	if (low < bound){
+
+		u64 threshold = -bound % bound;
+		while (low < threshold)
+			high = mul_64x64(rng_next(rng), bound, &low);
+
+	}
+
+	return high;
+
+}
+
+// the float analogue of rng_unit, from the top 23 bits
+static inline float rng_unit_f(u64 bits){
+
+	float f;
+	u32 x = (u32)(bits >> 41) | FLOAT_ONE;
+	memcpy(&f, &x, sizeof(f));
+
+	return f - 1.0f;
+
+}
+
+double rng_uniform(Rng *rng){
+
+	return rng_unit(rng_next(rng));
+
+}
+
+// n raw draws, the same values n calls of rng_next would return. Philox
+// finishes a partly read block first, then computes whole blocks straight
+// into bits. The fills below map each chunk of bits to floating point in
+// a separate loop.
+void rng_fill_bits(Rng *rng, u64 *bits, size_t n){
+
+	size_t i = 0;
+
+	if (rng->kind == RNG_XOSHIRO){
+
+		u64 s[4] = {rng->s[0], rng->s[1], rng->s[2], rng->s[3]};
+		for (; i < n; i++) bits[i] = xoshiro_next(s);
+		memcpy(rng->s, s, sizeof(s));
+		return;
+
+	}
+
+	if (rng->used < 4 && i < n) bits[i++] = rng_next(rng);
+
+	u32 key[2] = {(u32)rng->s[0], (u32)(rng->s[0] >> 32)};
+	u32 block[4];
+
+	for (; i + 2 <= n; i += 2){
+
+		u64 b = rng->s[2]++;
+		u32 counter[4] = {(u32)b, (u32)(b >> 32), (u32)rng->s[1], (u32)(rng->s[1] >> 32)};
+
+		philox4x32(block, counter, key);
+		bits[i] = block[0] | ((u64)block[1] << 32);
+		bits[i + 1] = block[2] | ((u64)block[3] << 32);
+
+	}
+
+	for (; i < n; i++) bits[i] = rng_next(rng);
+
+}
+
+void rng_fill_uniform(Rng *rng, double *out, size_t n, double min, double max){
+
+	u64 bits[RNG_CHUNK];
+	double span = max - min;
+
+	for (size_t start = 0; start < n; start += RNG_CHUNK){
+
+		size_t len = n - start < RNG_CHUNK ? n - start : RNG_CHUNK;
+		double *o = out + start;
+
+		rng_fill_bits(rng, bits, len);
+
+		for (size_t i = 0; i < len; i++)
+			o[i] = min + span * rng_unit(bits[i]);
+
+	}
+
+}
+
+void rng_fill_uniform_f(Rng *rng, float *out, size_t n, float min, float max){
+
+	u64 bits[RNG_CHUNK];
+	float span = max - min;
+
+	for (size_t start = 0; start < n; start += RNG_CHUNK){
+
+		size_t len = n - start < RNG_CHUNK ? n - start : RNG_CHUNK;
+		float *o = out + start;
+
+		rng_fill_bits(rng, bits, len);
+
+		for (size_t i = 0; i < len; i++)
+			o[i] = min + span * rng_unit_f(bits[i]);
+
+	}
+
+}
+
+// the generator behind random_seed, random_uniform and random_normal;
+// like rand() it is shared, so threads should seed their own Rng instead
+Rng *rng_default(void){
+
+	if (!default_ready){
+
+		rng_seed(&default_rng, RNG_XOSHIRO, 1);
+		default_ready = 1;
+
+	}
+
+	return &default_rng;
+
+}
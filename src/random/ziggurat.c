@@ -0,0 +1,130 @@
+#include <math.h>
+#include <pthread.h>
+#include "../../include/random/ziggurat.h"
+
+// Layer i is the rectangle [0, zig_x[i]] x [f(zig_x[i]), f(zig_x[i + 1])]
+// under f(x) = exp(-x^2 / 2); every layer has area ZIGGURAT_V. Layer 0 is
+// the base strip below f(R) together with the tail beyond R, folded into
+// a rectangle of the same area.
+static double zig_x[ZIGGURAT_LAYERS + 1];
+static double zig_f[ZIGGURAT_LAYERS + 1];
+static pthread_once_t zig_once = PTHREAD_ONCE_INIT;
+
+static void zig_build(void){
+
+	double r = ZIGGURAT_R;
+	double fr = exp(-0.5 * r * r);
+
+	zig_x[0] = ZIGGURAT_V / fr;
+	zig_x[1] = r;
+
+	for (int i = 2; i < ZIGGURAT_LAYERS; i++)
+		zig_x[i] = sqrt(-2.0 * log(ZIGGURAT_V / zig_x[i - 1] + exp(-0.5 * zig_x[i - 1] * zig_x[i - 1])));
+
+	zig_x[ZIGGURAT_LAYERS] = 0.0;
+
+	for (int i = 0; i <= ZIGGURAT_LAYERS; i++)
+		zig_f[i] = exp(-0.5 * zig_x[i] * zig_x[i]);
+
+}
+
+// One draw r picks the layer (bits 0-7), the sign (bit 8) and the
+// position (bits 12-63). About 99% of draws land strictly inside their
+// layer's rectangle and cost a multiply and a compare. The rest sample
+// the wedge against f, or the tail beyond R (Marsaglia's method), with
+// fresh draws.
+static inline double zig_sample(Rng *rng, u64 r){
+
+	for (;;){
+
+		int layer = (int)(r & 0xFF);
+		double sign = (r & 0x100) ? -1.0 : 1.0;
+		double x = rng_unit(r) * zig_x[layer];
+
+		if (x < zig_x[layer + 1]) return sign * x;
+
+		if (layer == 0){
+
+			double a, b;
+			do {
+
+				a = -log(1.0 - rng_uniform(rng)) / ZIGGURAT_R;
+				b = -log(1.0 - rng_uniform(rng));
+
+			} while (b + b < a * a);
+
+			return sign * (ZIGGURAT_R + a);
+
+		}
+
+		if (zig_f[layer] + (zig_f[layer + 1] - zig_f[layer]) * rng_uniform(rng) < exp(-0.5 * x * x))
+			return sign * x;
+
+		r = rng_next(rng);
+
+	}
+
+}
+
+double rng_normal(Rng *rng){
+
+	pthread_once(&zig_once, zig_build);
+
+	return zig_sample(rng, rng_next(rng));
+
+}
+
+// The first draw of every sample comes from a bulk chunk; only the rare
+// rejections go back to the generator, so a fill is reproducible for a
+// given state but is not the same sequence as n calls to rng_normal.
+void rng_fill_normal(Rng *rng, double *out, size_t n, double mean, double std){
+
+	u64 bits[RNG_CHUNK];
+
+	pthread_once(&zig_once, zig_build);
+
+	for (size_t start = 0; start < n; start += RNG_CHUNK){
+
+		size_t len = n - start < RNG_CHUNK ? n - start : RNG_CHUNK;
+		double *o = out + start;
+
+		rng_fill_bits(rng, bits, len);
+
+		for (size_t i = 0; i < len; i++)
+			o[i] = mean + std * zig_sample(rng, bits[i]);
+
+	}
+
+}
+
+void rng_fill_normal_f(Rng *rng, float *out, size_t n, float mean, float std){
+
+	u64 bits[RNG_CHUNK];
+
+	pthread_once(&zig_once, zig_build);
+
+	for (size_t start = 0; start < n; start += RNG_CHUNK){
+
+		size_t len = n - start < RNG_CHUNK ? n - start : RNG_CHUNK;
+		float *o = out + start;
+
+		rng_fill_bits(rng, bits, len);
+
+		for (size_t i = 0; i < len; i++)
+			o[i] = mean + std * (float)zig_sample(rng, bits[i]);
+
+	}
+
+}
+
+// Rejection: samples outside [lo, hi] are redrawn. Meant for bounds that
+// hold a fair share of the mass, such as two standard deviations.
+void rng_fill_truncated_normal(Rng *rng, double *out, size_t n, double mean, double std, double lo, double hi){
+
+	rng_fill_normal(rng, out, n, mean, std);
+
+	for (size_t i = 0; i < n; i++)
+		while (out[i] < lo || out[i] > hi)
+			out[i] = mean + std * rng_normal(rng);
+
+}
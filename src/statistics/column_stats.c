@@ -0,0 +1,35 @@
+#include <stddef.h>
+#include "../../include/statistics/column_stats.h"
+
+// Welford's update applied a whole row at a time: the row index is shared
+// by every column, so the inner loop runs over contiguous memory
+void column_moments(double *x, int rows, int cols, double *mean, double *var){
+
+	for (int j = 0; j < cols; j++){
+
+		mean[j] = 0.0;
+		var[j] = 0.0;
+
+	}
+
+	for (int i = 0; i < rows; i++){
+
+		double *row = x + (size_t)i * cols;
+		double inv = 1.0 / (i + 1);
+
+		for (int j = 0; j < cols; j++){
+
+			double delta = row[j] - mean[j];
+			mean[j] += delta * inv;
+			var[j] += delta * (row[j] - mean[j]);
+
+		}
+
+	}
+
+	if (rows == 0) return;
+
+	for (int j = 0; j < cols; j++)
+		var[j] /= rows;
+
+}
@@ -0,0 +1,64 @@
+#include "../../include/training/activation_inplace.h"
+#include "../../include/activations/relu.h"
+#include "../../include/activations/sigmoid.h"
+#include "../../include/primitive/exponents.h"
+
+#define opendi_e 2.7182818284590452353602874713527
+
+void activation_forward_inplace(double *h, int m, int p, ActivationType act){
+
+	int total = m * p;
+
+	if (act == ACTIVATION_RELU){
+
+		for (int i = 0; i < total; i++)
+			h[i] = relu(h[i]);
+
+	} else if (act == ACTIVATION_SIGMOID){
+
+		for (int i = 0; i < total; i++)
+			h[i] = sigmoid(h[i]);
+
+	} else if (act == ACTIVATION_SOFTMAX){
+
+		for (int i = 0; i < m; i++){
+
+			double *row = h + i * p;
+
+			double max = row[0];
+			for (int j = 1; j < p; j++)
+				if (row[j] > max) max = row[j];
+
+			double sum = 0.0;
+			for (int j = 0; j < p; j++){
+
+				row[j] = exponents(opendi_e, row[j] - max);
+				sum += row[j];
+
+			}
+
+			for (int j = 0; j < p; j++)
+				row[j] /= sum;
+
+		}
+
+	}
+
+}
+
+// relu(z) > 0 exactly when z > 0, so the activated output doubles as the relu cache
+void activation_backward_inplace(double *g, double *h, int total, ActivationType act){
+
+	if (act == ACTIVATION_RELU){
+
+		for (int i = 0; i < total; i++)
+			if (h[i] <= 0.0) g[i] = 0.0;
+
+	} else if (act == ACTIVATION_SIGMOID){
+
+		for (int i = 0; i < total; i++)
+			g[i] *= h[i] * (1.0 - h[i]);
+
+	}
+
+}
@@ -0,0 +1,231 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <time.h>
+#include "../../include/training/hogwild_trainer.h"
+#include "../../include/training/activation_inplace.h"
+#include "../../include/linalg/matricies/gemm.h"
+#include "../../include/loss/mse_loss.h"
+#include "../../include/loss/cross_entropy.h"
+
+static double now_seconds(void){
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+
+}
+
+/*
+ * One lock-free step on the shared weights. Weights are read and written with
+ * plain loads and stores while other workers do the same: a worker may see a
+ * mix of old and new values, and concurrent read-modify-writes of the same
+ * weight can lose one of the updates. Aligned 8-byte stores are not torn on
+ * the targets we build for, so every value read is one some worker wrote.
+ */
+static double hogwild_step(HogwildWorker *w, int m){
+
+	HogwildTrainer *t = w->owner;
+	int L = t->n_layers;
+	int p_out = t->layers[L - 1].n_out;
+	double **acts = arena_push(w->arena, (L + 1) * sizeof(double *));
+
+	acts[0] = w->x_batch;
+
+	// forward: gemm skips zero inputs, so sparse rows cost only their non-zeros
+	for (int l = 0; l < L; l++){
+
+		DenseLayer *layer = &t->layers[l];
+
+		acts[l + 1] = arena_push(w->arena, (u64)m * layer->n_out * sizeof(double));
+		gemm(acts[l + 1], acts[l], layer->weights, m, layer->n_in, layer->n_out, 0, 0, 1.0, 0.0);
+		activation_forward_inplace(acts[l + 1], m, layer->n_out, layer->act);
+
+	}
+
+	double *pred = acts[L];
+	double *y = w->y_batch;
+	int total = m * p_out;
+	double *g = arena_push(w->arena, (u64)total * sizeof(double));
+	double loss;
+
+	if (t->loss == LOSS_CROSS_ENTROPY){
+
+		loss = cross_entropy(pred, y, total);
+		for (int i = 0; i < total; i++)
+			g[i] = (pred[i] - y[i]) / m;
+
+	} else {
+
+		loss = mse_loss(pred, y, total);
+		for (int i = 0; i < total; i++)
+			g[i] = 2.0 * (pred[i] - y[i]) / total;
+
+	}
+
+	for (int l = L - 1; l >= 0; l--){
+
+		DenseLayer *layer = &t->layers[l];
+		int n = layer->n_in;
+		int p = layer->n_out;
+		double *g_prev = NULL;
+
+		activation_backward_inplace(g, acts[l + 1], m * p, layer->act);
+
+		if (l > 0){
+
+			g_prev = arena_push(w->arena, (u64)m * n * sizeof(double));
+			gemm(g_prev, g, layer->weights, m, p, n, 0, 1, 1.0, 0.0);
+
+		}
+
+		// W -= lr * input^T @ g straight into the shared weights; weight rows
+		// whose input feature is zero for a sample are skipped for that sample
+		gemm(layer->weights, acts[l], g, n, m, p, 1, 0, -t->lr, 1.0);
+
+		g = g_prev;
+
+	}
+
+	return loss;
+
+}
+
+static void *worker_main(void *arg){
+
+	HogwildWorker *w = arg;
+	HogwildTrainer *t = w->owner;
+	u64 mark = arena_pos(w->arena);
+
+	w->loss_sum = 0.0;
+	w->n_steps = 0;
+	w->n_samples = 0;
+
+	int m;
+	while ((m = batch_iterator_next_shared(t->it, w->x_batch, w->y_batch)) > 0){
+
+		w->loss_sum += hogwild_step(w, m) * m;
+		w->n_steps++;
+		w->n_samples += m;
+
+		arena_pop_to(w->arena, mark);
+
+	}
+
+	return NULL;
+
+}
+
+HogwildTrainer *hogwild_trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr, int n_threads){
+
+	if (n_threads < 1) return NULL;
+
+	HogwildTrainer *t = malloc(sizeof(*t));
+	if (!t) return NULL;
+
+	t->layers = layers;
+	t->n_layers = n_layers;
+	t->loss = loss;
+	t->batch_size = batch_size;
+	t->lr = lr;
+	t->n_threads = n_threads;
+	t->it = NULL;
+	t->workers = calloc(n_threads, sizeof(HogwildWorker));
+	t->threads = calloc(n_threads, sizeof(pthread_t));
+
+	if (!t->workers || !t->threads){
+
+		hogwild_trainer_destroy(t);
+		return NULL;
+
+	}
+
+	u64 x_bytes = (u64)batch_size * layers[0].n_in * sizeof(double);
+	u64 y_bytes = (u64)batch_size * layers[n_layers - 1].n_out * sizeof(double);
+
+	for (int i = 0; i < n_threads; i++){
+
+		HogwildWorker *w = &t->workers[i];
+		w->owner = t;
+		w->arena = arena_create_ex(0, ARENA_GROWABLE);
+		if (!w->arena){
+
+			hogwild_trainer_destroy(t);
+			return NULL;
+
+		}
+
+		// each worker's arena starts on its own pages, so workers never share a cache line
+		w->x_batch = arena_push(w->arena, x_bytes);
+		w->y_batch = arena_push(w->arena, y_bytes);
+
+	}
+
+	return t;
+
+}
+
+EpochStats hogwild_train_epoch(HogwildTrainer *t, BatchIterator *it){
+
+	EpochStats stats = {0};
+
+	// the batch buffers hold t->batch_size rows; n_steps = -1 flags the mismatch
+	if (it->batch_size > t->batch_size){
+
+		stats.n_steps = -1;
+		return stats;
+
+	}
+
+	batch_iterator_shuffle(it);
+	t->it = it;
+
+	double start = now_seconds();
+
+	// the calling thread is worker 0
+	int started = 1;
+	for (int i = 1; i < t->n_threads; i++){
+
+		if (pthread_create(&t->threads[i], NULL, worker_main, &t->workers[i]) != 0) break;
+		started++;
+
+	}
+
+	worker_main(&t->workers[0]);
+
+	for (int i = 1; i < started; i++)
+		pthread_join(t->threads[i], NULL);
+
+	stats.seconds = now_seconds() - start;
+
+	double loss_sum = 0.0;
+	for (int i = 0; i < started; i++){
+
+		loss_sum += t->workers[i].loss_sum;
+		stats.n_steps += t->workers[i].n_steps;
+		stats.n_samples += t->workers[i].n_samples;
+
+	}
+
+	stats.loss = stats.n_samples > 0 ? loss_sum / stats.n_samples : 0.0;
+	stats.samples_per_sec = stats.seconds > 0.0 ? stats.n_samples / stats.seconds : 0.0;
+	t->it = NULL;
+
+	return stats;
+
+}
+
+void hogwild_trainer_destroy(HogwildTrainer *t){
+
+	if (!t) return;
+
+	if (t->workers)
+		for (int i = 0; i < t->n_threads; i++)
+			arena_destroy(t->workers[i].arena);
+
+	free(t->workers);
+	free(t->threads);
+	free(t);
+
+}
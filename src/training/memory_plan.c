@@ -0,0 +1,259 @@
+#include <stdlib.h>
+#include "../../include/training/memory_plan.h"
+
+/*
+ * One training step is scheduled as:
+ *
+ *   forward of each layer (GEMM + activation in place)
+ *   loss gradient
+ *   for each segment of checkpoint_every layers, last segment first:
+ *     recompute of the segment's layers except its last
+ *     backward of each layer in the segment, last first:
+ *       activation backward, d_weights GEMM, d_input GEMM, SGD update
+ *
+ * With checkpoint_every == 1 every segment is a single layer and nothing
+ * is recomputed.
+ */
+
+typedef struct {
+	int *forward;
+	int *recompute;
+	int *act_back;
+	int *d_weights;
+	int *d_input;
+	int *update;
+	int loss;
+} Schedule;
+
+static int is_checkpoint(int l, int L, int every){
+
+	return (l + 1) % every == 0 || l == L - 1;
+
+}
+
+static int schedule_ops(Schedule *s, int L, int every){
+
+	int op = 0;
+
+	for (int l = 0; l < L; l++)
+		s->forward[l] = op++;
+
+	s->loss = op++;
+
+	for (int last = L - 1; last >= 0; ){
+
+		int first = last / every * every;
+
+		for (int l = first; l < last; l++)
+			s->recompute[l] = op++;
+
+		for (int l = last; l >= first; l--){
+
+			s->act_back[l] = op++;
+			s->d_weights[l] = op++;
+			s->d_input[l] = op++;
+			s->update[l] = op++;
+
+		}
+
+		last = first - 1;
+
+	}
+
+	return op;
+
+}
+
+static u64 align_up(u64 x){
+
+	return (x + (PLAN_ALIGNMENT - 1)) & ~(u64)(PLAN_ALIGNMENT - 1);
+
+}
+
+static int add_buffer(MemoryPlan *plan, u64 n_doubles, int first, int last){
+
+	PlanBuffer *b = &plan->buffers[plan->n_buffers];
+
+	b->size = align_up(n_doubles * sizeof(double));
+	b->offset = 0;
+	b->first = first;
+	b->last = last;
+
+	return plan->n_buffers++;
+
+}
+
+static int lifetimes_overlap(PlanBuffer *a, PlanBuffer *b){
+
+	return a->first <= b->last && b->first <= a->last;
+
+}
+
+static void assign_offsets(MemoryPlan *plan){
+
+	int n = plan->n_buffers;
+	int *order = malloc(n * sizeof(int));
+	int *placed = malloc(n * sizeof(int));
+	int n_placed = 0;
+
+	// greedy by size: largest buffers first, each at the lowest offset
+	// that does not collide with a placed buffer whose lifetime overlaps
+	for (int i = 0; i < n; i++)
+		order[i] = i;
+
+	for (int i = 1; i < n; i++){
+
+		int key = order[i];
+		int j = i - 1;
+		while (j >= 0 && plan->buffers[order[j]].size < plan->buffers[key].size){
+
+			order[j + 1] = order[j];
+			j--;
+
+		}
+		order[j + 1] = key;
+
+	}
+
+	plan->total_bytes = 0;
+	plan->naive_bytes = 0;
+
+	for (int i = 0; i < n; i++){
+
+		PlanBuffer *b = &plan->buffers[order[i]];
+		u64 offset = 0;
+		int moved = 1;
+
+		while (moved){
+
+			moved = 0;
+
+			for (int j = 0; j < n_placed; j++){
+
+				PlanBuffer *o = &plan->buffers[placed[j]];
+				if (!lifetimes_overlap(b, o)) continue;
+
+				if (offset < o->offset + o->size && o->offset < offset + b->size){
+
+					offset = o->offset + o->size;
+					moved = 1;
+
+				}
+
+			}
+
+		}
+
+		b->offset = offset;
+		placed[n_placed++] = order[i];
+
+		if (offset + b->size > plan->total_bytes)
+			plan->total_bytes = offset + b->size;
+		plan->naive_bytes += b->size;
+
+	}
+
+	free(order);
+	free(placed);
+
+}
+
+MemoryPlan *memory_plan_create(DenseLayer *layers, int n_layers, int batch_size){
+
+	return memory_plan_create_checkpointed(layers, n_layers, batch_size, 1);
+
+}
+
+MemoryPlan *memory_plan_create_checkpointed(DenseLayer *layers, int n_layers, int batch_size, int checkpoint_every){
+
+	int L = n_layers;
+	u64 m = batch_size;
+
+	if (n_layers < 1 || batch_size < 1 || checkpoint_every < 1) return NULL;
+
+	MemoryPlan *plan = malloc(sizeof(*plan));
+	if (!plan) return NULL;
+
+	Schedule s;
+	plan->buffers = malloc((4 * L + 2) * sizeof(PlanBuffer));
+	plan->hidden = malloc(4 * L * sizeof(int));
+	s.forward = malloc(6 * L * sizeof(int));
+
+	if (!plan->buffers || !plan->hidden || !s.forward){
+
+		free(plan->buffers);
+		free(plan->hidden);
+		free(s.forward);
+		free(plan);
+		return NULL;
+
+	}
+
+	s.recompute = s.forward + L;
+	s.act_back = s.forward + 2 * L;
+	s.d_weights = s.forward + 3 * L;
+	s.d_input = s.forward + 4 * L;
+	s.update = s.forward + 5 * L;
+
+	plan->grad = plan->hidden + L;
+	plan->d_weights = plan->hidden + 2 * L;
+	plan->recompute = plan->hidden + 3 * L;
+	plan->n_buffers = 0;
+	plan->n_ops = schedule_ops(&s, L, checkpoint_every);
+	plan->n_layers = L;
+	plan->batch_size = batch_size;
+	plan->checkpoint_every = checkpoint_every;
+
+	plan->input = add_buffer(plan, m * layers[0].n_in, 0, s.d_weights[0]);
+	plan->target = add_buffer(plan, m * layers[L - 1].n_out, 0, s.loss);
+
+	for (int l = 0; l < L; l++){
+
+		u64 n = layers[l].n_in;
+		u64 p = layers[l].n_out;
+
+		int grad_first = (l == L - 1) ? s.loss : s.d_input[l + 1];
+		int grad_last = (l == 0) ? s.d_weights[0] : s.d_input[l];
+
+		// between checkpoints the forward output only lives until the next
+		// layer reads it; backward reads a recomputed copy instead
+		if (is_checkpoint(l, L, checkpoint_every)){
+
+			plan->hidden[l] = add_buffer(plan, m * p, s.forward[l], s.act_back[l]);
+			plan->recompute[l] = -1;
+
+		} else {
+
+			plan->hidden[l] = add_buffer(plan, m * p, s.forward[l], s.forward[l + 1]);
+			plan->recompute[l] = add_buffer(plan, m * p, s.recompute[l], s.act_back[l]);
+
+		}
+
+		plan->grad[l] = add_buffer(plan, m * p, grad_first, grad_last);
+		plan->d_weights[l] = add_buffer(plan, n * p, s.d_weights[l], s.update[l]);
+
+	}
+
+	free(s.forward);
+
+	assign_offsets(plan);
+
+	return plan;
+
+}
+
+double *memory_plan_buffer(MemoryPlan *plan, void *base, int id){
+
+	return (double *)((u8 *)base + plan->buffers[id].offset);
+
+}
+
+void memory_plan_destroy(MemoryPlan *plan){
+
+	if (!plan) return;
+
+	free(plan->buffers);
+	free(plan->hidden);
+	free(plan);
+
+}
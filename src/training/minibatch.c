@@ -0,0 +1,114 @@
+#include <stdlib.h>
+#include <string.h>
+#include "../../include/training/minibatch.h"
+#include "../../include/random/rng.h"
+
+BatchIterator *batch_iterator_create(double *features, double *targets, int n_samples, int n_features, int n_targets, int batch_size){
+
+	BatchIterator *it = malloc(sizeof(*it));
+	if (!it) return NULL;
+
+	it->order = malloc(n_samples * sizeof(int));
+	if (!it->order){
+
+		free(it);
+		return NULL;
+
+	}
+
+	for (int i = 0; i < n_samples; i++)
+		it->order[i] = i;
+
+	it->features = features;
+	it->targets = targets;
+	it->n_samples = n_samples;
+	it->n_features = n_features;
+	it->n_targets = n_targets;
+	it->batch_size = batch_size;
+	it->cursor = 0;
+
+	return it;
+
+}
+
+void batch_iterator_shuffle(BatchIterator *it){
+
+	for (int i = it->n_samples - 1; i > 0; i--){
+
+		int j = (int)rng_below(rng_default(), i + 1);
+		int tmp = it->order[i];
+		it->order[i] = it->order[j];
+		it->order[j] = tmp;
+
+	}
+
+	it->cursor = 0;
+
+}
+
+void batch_iterator_reset(BatchIterator *it){
+
+	it->cursor = 0;
+
+}
+
+static void gather_rows(BatchIterator *it, int start, int rows, double *x_out, double *y_out){
+
+	for (int i = 0; i < rows; i++){
+
+		int src = it->order[start + i];
+
+		memcpy(x_out + (size_t)i * it->n_features,
+		       it->features + (size_t)src * it->n_features,
+		       it->n_features * sizeof(double));
+
+		if (y_out)
+			memcpy(y_out + (size_t)i * it->n_targets,
+			       it->targets + (size_t)src * it->n_targets,
+			       it->n_targets * sizeof(double));
+
+	}
+
+}
+
+int batch_iterator_next(BatchIterator *it, double *x_out, double *y_out){
+
+	int rows = it->n_samples - it->cursor;
+	if (rows > it->batch_size) rows = it->batch_size;
+	if (rows <= 0) return 0;
+
+	gather_rows(it, it->cursor, rows, x_out, y_out);
+	it->cursor += rows;
+
+	return rows;
+
+}
+
+int batch_iterator_next_shared(BatchIterator *it, double *x_out, double *y_out){
+
+	// claim the batch with one atomic add; the cursor may run past n_samples
+#if defined(__GNUC__) || defined(__clang__)
+	int start = __atomic_fetch_add(&it->cursor, it->batch_size, __ATOMIC_RELAXED);
+#else
+	int start = it->cursor;
+	it->cursor += it->batch_size;
+#endif
+
+	int rows = it->n_samples - start;
+	if (rows > it->batch_size) rows = it->batch_size;
+	if (rows <= 0) return 0;
+
+	gather_rows(it, start, rows, x_out, y_out);
+
+	return rows;
+
+}
+
+void batch_iterator_destroy(BatchIterator *it){
+
+	if (!it) return;
+
+	free(it->order);
+	free(it);
+
+}
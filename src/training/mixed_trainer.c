@@ -0,0 +1,339 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+#include "../../include/training/mixed_trainer.h"
+#include "../../include/linalg/matricies/gemm_f32.h"
+
+static double now_seconds(void){
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+
+}
+
+static void activation_forward_f32(float *h, int m, int p, ActivationType act){
+
+	int total = m * p;
+
+	if (act == ACTIVATION_RELU){
+
+		for (int i = 0; i < total; i++)
+			if (h[i] < 0.0f) h[i] = 0.0f;
+
+	} else if (act == ACTIVATION_SIGMOID){
+
+		for (int i = 0; i < total; i++)
+			h[i] = 1.0f / (1.0f + expf(-h[i]));
+
+	} else if (act == ACTIVATION_SOFTMAX){
+
+		for (int i = 0; i < m; i++){
+
+			float *row = h + (size_t)i * p;
+
+			float max = row[0];
+			for (int j = 1; j < p; j++)
+				if (row[j] > max) max = row[j];
+
+			float sum = 0.0f;
+			for (int j = 0; j < p; j++){
+
+				row[j] = expf(row[j] - max);
+				sum += row[j];
+
+			}
+
+			for (int j = 0; j < p; j++)
+				row[j] /= sum;
+
+		}
+
+	}
+
+}
+
+static int all_finite_f32(const float *v, int n){
+
+	for (int i = 0; i < n; i++)
+		if (!isfinite(v[i])) return 0;
+
+	return 1;
+
+}
+
+static void activation_backward_f32(float *g, float *h, int total, ActivationType act){
+
+	if (act == ACTIVATION_RELU){
+
+		for (int i = 0; i < total; i++)
+			if (h[i] <= 0.0f) g[i] = 0.0f;
+
+	} else if (act == ACTIVATION_SIGMOID){
+
+		for (int i = 0; i < total; i++)
+			g[i] *= h[i] * (1.0f - h[i]);
+
+	}
+
+}
+
+MixedTrainer *mixed_trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr){
+
+	int L = n_layers;
+	u64 m = batch_size;
+
+	MixedTrainer *t = malloc(sizeof(*t));
+	if (!t) return NULL;
+
+	// w_f, h, g and dw share one pointer array
+	t->w_f = malloc(4 * L * sizeof(float *));
+	if (!t->w_f){
+
+		free(t);
+		return NULL;
+
+	}
+
+	t->h = t->w_f + L;
+	t->g = t->h + L;
+	t->dw = t->g + L;
+
+	u64 in_bytes = m * layers[0].n_in;
+	u64 out_bytes = m * layers[L - 1].n_out;
+	u64 bytes = arena_align_up(in_bytes * sizeof(float), ALIGNMENT)
+	          + arena_align_up(in_bytes * sizeof(double), ALIGNMENT)
+	          + arena_align_up(out_bytes * sizeof(double), ALIGNMENT);
+
+	for (int l = 0; l < L; l++){
+
+		u64 n_w = (u64)layers[l].n_in * layers[l].n_out;
+		u64 n_h = m * layers[l].n_out;
+
+		bytes += 2 * arena_align_up(n_w * sizeof(float), ALIGNMENT);
+		bytes += 2 * arena_align_up(n_h * sizeof(float), ALIGNMENT);
+
+	}
+
+	t->arena = arena_create(bytes);
+	if (!t->arena){
+
+		free(t->w_f);
+		free(t);
+		return NULL;
+
+	}
+
+	t->x_f = arena_push(t->arena, in_bytes * sizeof(float));
+	t->x_batch = arena_push(t->arena, in_bytes * sizeof(double));
+	t->y_batch = arena_push(t->arena, out_bytes * sizeof(double));
+
+	for (int l = 0; l < L; l++){
+
+		u64 n_w = (u64)layers[l].n_in * layers[l].n_out;
+		u64 n_h = m * layers[l].n_out;
+
+		t->w_f[l] = arena_push(t->arena, n_w * sizeof(float));
+		t->dw[l] = arena_push(t->arena, n_w * sizeof(float));
+		t->h[l] = arena_push(t->arena, n_h * sizeof(float));
+		t->g[l] = arena_push(t->arena, n_h * sizeof(float));
+
+	}
+
+	t->layers = layers;
+	t->n_layers = L;
+	t->loss = loss;
+	t->batch_size = batch_size;
+	t->lr = lr;
+	t->loss_scale = MIXED_INIT_SCALE;
+	t->growth_interval = MIXED_GROWTH_INTERVAL;
+	t->good_steps = 0;
+	t->n_skipped = 0;
+
+	mixed_trainer_sync(t);
+
+	return t;
+
+}
+
+void mixed_trainer_sync(MixedTrainer *t){
+
+	for (int l = 0; l < t->n_layers; l++){
+
+		int n_w = t->layers[l].n_in * t->layers[l].n_out;
+		double *w = t->layers[l].weights;
+		float *w_f = t->w_f[l];
+
+		for (int i = 0; i < n_w; i++)
+			w_f[i] = (float)w[i];
+
+	}
+
+}
+
+double mixed_train_step(MixedTrainer *t, double *x, double *y, int m){
+
+	int L = t->n_layers;
+	int n_in = t->layers[0].n_in;
+	int p_out = t->layers[L - 1].n_out;
+
+	for (int i = 0; i < m * n_in; i++)
+		t->x_f[i] = (float)x[i];
+
+	for (int l = 0; l < L; l++){
+
+		DenseLayer *layer = &t->layers[l];
+		float *in = l == 0 ? t->x_f : t->h[l - 1];
+
+		gemm_f32(t->h[l], in, t->w_f[l], m, layer->n_in, layer->n_out, 0, 0, 1.0f, 0.0f);
+		activation_forward_f32(t->h[l], m, layer->n_out, layer->act);
+
+	}
+
+	// the loss is reduced in double; its gradient is scaled before going to float
+	float *pred = t->h[L - 1];
+	float *g = t->g[L - 1];
+	int total = m * p_out;
+	double scale = t->loss_scale;
+	double loss = 0.0;
+
+	if (t->loss == LOSS_CROSS_ENTROPY){
+
+		for (int i = 0; i < total; i++){
+
+			loss -= y[i] * log((double)pred[i] + 1e-15);
+			g[i] = (float)(scale * (pred[i] - y[i]) / m);
+
+		}
+
+		loss /= total;
+
+	} else {
+
+		for (int i = 0; i < total; i++){
+
+			double diff = pred[i] - y[i];
+			loss += diff * diff;
+			g[i] = (float)(scale * 2.0 * diff / total);
+
+		}
+
+		loss /= total;
+
+	}
+
+	// gemm_f32 skips zero entries of a, so a non-finite delta paired with a zero
+	// activation would never reach dw - check each delta before it is used
+	int overflow = 0;
+
+	for (int l = L - 1; l >= 0; l--){
+
+		DenseLayer *layer = &t->layers[l];
+		int n = layer->n_in;
+		int p = layer->n_out;
+		float *in = l == 0 ? t->x_f : t->h[l - 1];
+
+		activation_backward_f32(t->g[l], t->h[l], m * p, layer->act);
+
+		if (!all_finite_f32(t->g[l], m * p)){
+
+			overflow = 1;
+			break;
+
+		}
+
+		gemm_f32(t->dw[l], in, t->g[l], n, m, p, 1, 0, 1.0f, 0.0f);
+
+		if (l > 0)
+			gemm_f32(t->g[l - 1], t->g[l], t->w_f[l], m, p, n, 0, 1, 1.0f, 0.0f);
+
+	}
+
+	for (int l = 0; l < L && !overflow; l++)
+		overflow = !all_finite_f32(t->dw[l], t->layers[l].n_in * t->layers[l].n_out);
+
+	// an overflow anywhere skips the whole step and halves the scale
+	if (overflow){
+
+		if (t->loss_scale > 1.0) t->loss_scale *= 0.5;
+		t->good_steps = 0;
+		t->n_skipped++;
+		return loss;
+
+	}
+
+	double step = t->lr / scale;
+
+	for (int l = 0; l < L; l++){
+
+		int n_w = t->layers[l].n_in * t->layers[l].n_out;
+		double *w = t->layers[l].weights;
+		float *w_f = t->w_f[l];
+		float *dw = t->dw[l];
+
+		for (int i = 0; i < n_w; i++){
+
+			w[i] -= step * dw[i];
+			w_f[i] = (float)w[i];
+
+		}
+
+	}
+
+	if (++t->good_steps == t->growth_interval){
+
+		t->loss_scale *= 2.0;
+		t->good_steps = 0;
+
+	}
+
+	return loss;
+
+}
+
+EpochStats mixed_train_epoch(MixedTrainer *t, BatchIterator *it){
+
+	EpochStats stats = {0};
+	double loss_sum = 0.0;
+
+	// the batch buffers hold t->batch_size rows; n_steps = -1 flags the mismatch
+	if (it->batch_size > t->batch_size){
+
+		stats.n_steps = -1;
+		return stats;
+
+	}
+
+	batch_iterator_shuffle(it);
+
+	double start = now_seconds();
+
+	int m;
+	while ((m = batch_iterator_next(it, t->x_batch, t->y_batch)) > 0){
+
+		loss_sum += mixed_train_step(t, t->x_batch, t->y_batch, m) * m;
+		stats.n_steps++;
+		stats.n_samples += m;
+
+	}
+
+	stats.seconds = now_seconds() - start;
+	stats.loss = stats.n_samples > 0 ? loss_sum / stats.n_samples : 0.0;
+	stats.samples_per_sec = stats.seconds > 0.0 ? stats.n_samples / stats.seconds : 0.0;
+
+	return stats;
+
+}
+
+void mixed_trainer_destroy(MixedTrainer *t){
+
+	if (!t) return;
+
+	arena_destroy(t->arena);
+	free(t->w_f);
+	free(t);
+
+}
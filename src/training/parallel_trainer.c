@@ -0,0 +1,366 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdlib.h>
+#include <time.h>
+#include "../../include/training/parallel_trainer.h"
+#include "../../include/pipeline/dense_forward.h"
+#include "../../include/pipeline/dense_backward.h"
+#include "../../include/pipeline/mse_backward.h"
+#include "../../include/pipeline/cross_entropy_backward.h"
+#include "../../include/loss/mse_loss.h"
+#include "../../include/loss/cross_entropy.h"
+
+// reduce chunks are whole cache lines so no two threads write the same line of W
+#define REDUCE_CHUNK_ALIGN 8
+
+static double now_seconds(void){
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+
+}
+
+static int barrier_init(TrainBarrier *b, int n_threads){
+
+	if (pthread_mutex_init(&b->lock, NULL) != 0) return -1;
+	if (pthread_cond_init(&b->cond, NULL) != 0){
+
+		pthread_mutex_destroy(&b->lock);
+		return -1;
+
+	}
+
+	b->n_threads = n_threads;
+	b->waiting = 0;
+	b->generation = 0;
+
+	return 0;
+
+}
+
+static void barrier_wait(TrainBarrier *b){
+
+	pthread_mutex_lock(&b->lock);
+
+	unsigned gen = b->generation;
+
+	if (++b->waiting == b->n_threads){
+
+		b->waiting = 0;
+		b->generation++;
+		pthread_cond_broadcast(&b->cond);
+
+	} else {
+
+		while (gen == b->generation)
+			pthread_cond_wait(&b->cond, &b->lock);
+
+	}
+
+	pthread_mutex_unlock(&b->lock);
+
+}
+
+static void barrier_destroy(TrainBarrier *b){
+
+	pthread_cond_destroy(&b->cond);
+	pthread_mutex_destroy(&b->lock);
+
+}
+
+static void shard_rows(int m, int n_threads, int id, int *start, int *rows){
+
+	int base = m / n_threads;
+	int extra = m % n_threads;
+
+	*start = id * base + (id < extra ? id : extra);
+	*rows = base + (id < extra ? 1 : 0);
+
+}
+
+// forward and backward of one shard on the worker's own arena
+static void shard_pass(TrainWorker *w){
+
+	ParallelTrainer *t = w->owner;
+	int L = t->n_layers;
+	int start;
+
+	arena_clear(w->arena);
+	shard_rows(t->m, t->n_threads, w->id, &start, &w->rows);
+
+	w->loss = 0.0;
+	if (w->rows == 0) return;
+
+	int m = w->rows;
+	int n_in = t->layers[0].n_in;
+	int p_out = t->layers[L - 1].n_out;
+	double *y = t->y + (size_t)start * p_out;
+
+	w->acts[0] = t->x + (size_t)start * n_in;
+
+	for (int l = 0; l < L; l++){
+
+		DenseLayer *layer = &t->layers[l];
+		w->acts[l + 1] = dense_forward(w->arena, w->acts[l], layer->weights, m,
+		                               layer->n_in, layer->n_out, layer->act, &w->caches[l]);
+
+	}
+
+	double *pred = w->acts[L];
+	double *g;
+
+	if (t->loss == LOSS_CROSS_ENTROPY){
+
+		w->loss = cross_entropy(pred, y, m * p_out);
+		g = cross_entropy_backward(w->arena, pred, y, m, p_out);
+
+	} else {
+
+		w->loss = mse_loss(pred, y, m * p_out);
+		g = mse_backward(w->arena, pred, y, m * p_out);
+
+	}
+
+	for (int l = L - 1; l >= 0; l--){
+
+		DenseLayer *layer = &t->layers[l];
+		ActivationType act = layer->act == ACTIVATION_SOFTMAX ? ACTIVATION_NONE : layer->act;
+
+		LayerGrad grad = dense_backward(w->arena, g, w->acts[l], layer->weights, w->caches[l],
+		                                m, layer->n_in, layer->n_out, act);
+
+		w->d_weights[l] = grad.d_weights;
+		g = grad.d_input;
+
+	}
+
+}
+
+// chunked all-reduce: each thread owns one contiguous slice of every weight
+// matrix, sums that slice across all workers and applies the SGD step to it
+static void reduce_step(TrainWorker *w){
+
+	ParallelTrainer *t = w->owner;
+	int T = t->n_threads;
+
+	for (int l = 0; l < t->n_layers; l++){
+
+		DenseLayer *layer = &t->layers[l];
+		int n_w = layer->n_in * layer->n_out;
+		int chunk = (n_w + T - 1) / T;
+		chunk = (chunk + REDUCE_CHUNK_ALIGN - 1) / REDUCE_CHUNK_ALIGN * REDUCE_CHUNK_ALIGN;
+
+		int lo = w->id * chunk;
+		int hi = lo + chunk < n_w ? lo + chunk : n_w;
+		if (lo >= hi) continue;
+
+		double *weights = layer->weights;
+
+		for (int s = 0; s < T; s++){
+
+			TrainWorker *src = &t->workers[s];
+			if (src->rows == 0) continue;
+
+			// shard gradients are shard means: weight each by its share of the batch
+			double scale = t->lr * src->rows / t->m;
+			double *dw = src->d_weights[l];
+			if (!dw) continue;
+
+			for (int i = lo; i < hi; i++)
+				weights[i] -= scale * dw[i];
+
+		}
+
+	}
+
+}
+
+static void *worker_main(void *arg){
+
+	TrainWorker *w = arg;
+	ParallelTrainer *t = w->owner;
+
+	for (;;){
+
+		barrier_wait(&t->barrier);
+		if (t->shutdown) break;
+
+		shard_pass(w);
+		barrier_wait(&t->barrier);
+
+		reduce_step(w);
+		barrier_wait(&t->barrier);
+
+	}
+
+	arena_scratch_release();
+
+	return NULL;
+
+}
+
+static void worker_free(TrainWorker *w){
+
+	arena_destroy(w->arena);
+	free(w->acts);
+
+}
+
+ParallelTrainer *parallel_trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr, int n_threads){
+
+	if (n_threads < 1) return NULL;
+
+	ParallelTrainer *t = calloc(1, sizeof(*t));
+	if (!t) return NULL;
+
+	t->layers = layers;
+	t->n_layers = n_layers;
+	t->loss = loss;
+	t->batch_size = batch_size;
+	t->lr = lr;
+	t->n_threads = n_threads;
+
+	t->workers = calloc(n_threads, sizeof(TrainWorker));
+	t->threads = calloc(n_threads, sizeof(pthread_t));
+	t->x_batch = malloc((size_t)batch_size * layers[0].n_in * sizeof(double));
+	t->y_batch = malloc((size_t)batch_size * layers[n_layers - 1].n_out * sizeof(double));
+
+	if (!t->workers || !t->threads || !t->x_batch || !t->y_batch) goto fail;
+
+	for (int i = 0; i < n_threads; i++){
+
+		TrainWorker *w = &t->workers[i];
+		w->owner = t;
+		w->id = i;
+		w->arena = arena_create_ex(0, ARENA_GROWABLE);
+
+		// acts (L + 1), caches (L) and d_weights (L) share one allocation
+		w->acts = malloc((3 * n_layers + 1) * sizeof(double *));
+		if (!w->arena || !w->acts){
+
+			worker_free(w);
+			w->arena = NULL;
+			w->acts = NULL;
+			goto fail;
+
+		}
+
+		w->caches = w->acts + n_layers + 1;
+		w->d_weights = w->caches + n_layers;
+
+	}
+
+	if (barrier_init(&t->barrier, n_threads) != 0) goto fail;
+
+	// the calling thread is worker 0
+	for (int i = 1; i < n_threads; i++){
+
+		if (pthread_create(&t->threads[i], NULL, worker_main, &t->workers[i]) != 0){
+
+			t->barrier.n_threads = i;
+			parallel_trainer_destroy(t);
+			return NULL;
+
+		}
+
+	}
+
+	return t;
+
+fail:
+
+	if (t->workers)
+		for (int i = 0; i < n_threads; i++)
+			if (t->workers[i].acts) worker_free(&t->workers[i]);
+
+	free(t->workers);
+	free(t->threads);
+	free(t->x_batch);
+	free(t->y_batch);
+	free(t);
+
+	return NULL;
+
+}
+
+double parallel_train_step(ParallelTrainer *t, double *x, double *y, int m){
+
+	t->x = x;
+	t->y = y;
+	t->m = m;
+
+	TrainWorker *self = &t->workers[0];
+
+	barrier_wait(&t->barrier);
+	shard_pass(self);
+	barrier_wait(&t->barrier);
+	reduce_step(self);
+	barrier_wait(&t->barrier);
+
+	double loss = 0.0;
+	for (int i = 0; i < t->n_threads; i++)
+		loss += t->workers[i].loss * t->workers[i].rows;
+
+	return m > 0 ? loss / m : 0.0;
+
+}
+
+EpochStats parallel_train_epoch(ParallelTrainer *t, BatchIterator *it){
+
+	EpochStats stats = {0};
+	double loss_sum = 0.0;
+
+	// the batch buffers hold t->batch_size rows; n_steps = -1 flags the mismatch
+	if (it->batch_size > t->batch_size){
+
+		stats.n_steps = -1;
+		return stats;
+
+	}
+
+	batch_iterator_shuffle(it);
+
+	double start = now_seconds();
+
+	int m;
+	while ((m = batch_iterator_next(it, t->x_batch, t->y_batch)) > 0){
+
+		loss_sum += parallel_train_step(t, t->x_batch, t->y_batch, m) * m;
+		stats.n_steps++;
+		stats.n_samples += m;
+
+	}
+
+	stats.seconds = now_seconds() - start;
+	stats.loss = stats.n_samples > 0 ? loss_sum / stats.n_samples : 0.0;
+	stats.samples_per_sec = stats.seconds > 0.0 ? stats.n_samples / stats.seconds : 0.0;
+
+	return stats;
+
+}
+
+void parallel_trainer_destroy(ParallelTrainer *t){
+
+	if (!t) return;
+
+	t->shutdown = 1;
+	barrier_wait(&t->barrier);
+
+	// fewer threads than workers only if thread creation failed
+	for (int i = 1; i < t->barrier.n_threads; i++)
+		pthread_join(t->threads[i], NULL);
+
+	barrier_destroy(&t->barrier);
+
+	for (int i = 0; i < t->n_threads; i++)
+		worker_free(&t->workers[i]);
+
+	free(t->workers);
+	free(t->threads);
+	free(t->x_batch);
+	free(t->y_batch);
+	free(t);
+
+}
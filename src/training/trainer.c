@@ -0,0 +1,349 @@
+#define _POSIX_C_SOURCE 199309L
+
+#include <math.h>
+#include <time.h>
+#include "../../include/training/trainer.h"
+#include "../../include/linalg/matricies/gemm.h"
+#include "../../include/training/activation_inplace.h"
+#include "../../include/loss/mse_loss.h"
+#include "../../include/loss/cross_entropy.h"
+
+static double now_seconds(void){
+
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+
+}
+
+Trainer *trainer_create(DenseLayer *layers, int n_layers, LossType loss, int batch_size, double lr){
+
+	Trainer *t = malloc(sizeof(*t));
+	if (!t) return NULL;
+
+	t->plan = memory_plan_create(layers, n_layers, batch_size);
+	if (!t->plan){
+
+		free(t);
+		return NULL;
+
+	}
+
+	t->arena = arena_create(t->plan->total_bytes);
+	if (!t->arena){
+
+		memory_plan_destroy(t->plan);
+		free(t);
+		return NULL;
+
+	}
+
+	t->layers = layers;
+	t->n_layers = n_layers;
+	t->loss = loss;
+	t->batch_size = batch_size;
+	t->lr = lr;
+	t->accum_steps = 1;
+	t->accum_samples = 0;
+	t->grads = NULL;
+	t->base = arena_push(t->arena, t->plan->total_bytes);
+	t->x_batch = memory_plan_buffer(t->plan, t->base, t->plan->input);
+	t->y_batch = memory_plan_buffer(t->plan, t->base, t->plan->target);
+
+	return t;
+
+}
+
+static void forward_layer(DenseLayer *layer, double *in, double *h, int m){
+
+	gemm(h, in, layer->weights, m, layer->n_in, layer->n_out, 0, 0, 1.0, 0.0);
+	activation_forward_inplace(h, m, layer->n_out, layer->act);
+
+}
+
+// the buffer backward reads layer l's activation from: its checkpoint, or
+// the copy recomputed for its segment
+static double *backward_activation(Trainer *t, int l){
+
+	MemoryPlan *plan = t->plan;
+	int id = plan->recompute[l] >= 0 ? plan->recompute[l] : plan->hidden[l];
+
+	return memory_plan_buffer(plan, t->base, id);
+
+}
+
+// One forward/backward pass. With accumulate set, each layer's weight gradient
+// is added into its persistent buffer (scaled by m so that train_apply can
+// divide by the sample count) instead of being applied immediately.
+static double run_step(Trainer *t, double *x, double *y, int m, int accumulate){
+
+	MemoryPlan *plan = t->plan;
+	int L = t->n_layers;
+	int p_out = t->layers[L - 1].n_out;
+
+	for (int l = 0; l < L; l++){
+
+		double *in = l == 0 ? x : memory_plan_buffer(plan, t->base, plan->hidden[l - 1]);
+		double *h = memory_plan_buffer(plan, t->base, plan->hidden[l]);
+
+		forward_layer(&t->layers[l], in, h, m);
+
+	}
+
+	double *pred = memory_plan_buffer(plan, t->base, plan->hidden[L - 1]);
+	double *g = memory_plan_buffer(plan, t->base, plan->grad[L - 1]);
+	int total = m * p_out;
+	double loss;
+
+	if (t->loss == LOSS_CROSS_ENTROPY){
+
+		loss = cross_entropy(pred, y, total);
+		for (int i = 0; i < total; i++)
+			g[i] = (pred[i] - y[i]) / m;
+
+	} else {
+
+		loss = mse_loss(pred, y, total);
+		for (int i = 0; i < total; i++)
+			g[i] = 2.0 * (pred[i] - y[i]) / total;
+
+	}
+
+	for (int l = L - 1; l >= 0; l--){
+
+		DenseLayer *layer = &t->layers[l];
+		int n = layer->n_in;
+		int p = layer->n_out;
+		int n_w = n * p;
+
+		// entering a segment from its checkpoint: rebuild the activations
+		// below it from the previous checkpoint
+		if (plan->recompute[l] < 0){
+
+			for (int r = l / plan->checkpoint_every * plan->checkpoint_every; r < l; r++)
+				forward_layer(&t->layers[r], r == 0 ? x : backward_activation(t, r - 1), backward_activation(t, r), m);
+
+		}
+
+		double *in = l == 0 ? x : backward_activation(t, l - 1);
+		double *h = backward_activation(t, l);
+		double *dw = NULL;
+		g = memory_plan_buffer(plan, t->base, plan->grad[l]);
+
+		activation_backward_inplace(g, h, m * p, layer->act);
+
+		if (accumulate){
+
+			gemm(t->grads[l], in, g, n, m, p, 1, 0, (double)m, 1.0);
+
+		} else {
+
+			dw = memory_plan_buffer(plan, t->base, plan->d_weights[l]);
+			gemm(dw, in, g, n, m, p, 1, 0, 1.0, 0.0);
+
+		}
+
+		if (l > 0){
+
+			double *g_prev = memory_plan_buffer(plan, t->base, plan->grad[l - 1]);
+			gemm(g_prev, g, layer->weights, m, p, n, 0, 1, 1.0, 0.0);
+
+		}
+
+		if (!accumulate)
+			for (int i = 0; i < n_w; i++)
+				layer->weights[i] -= t->lr * dw[i];
+
+	}
+
+	if (accumulate)
+		t->accum_samples += m;
+
+	return loss;
+
+}
+
+double train_step(Trainer *t, double *x, double *y, int m){
+
+	return run_step(t, x, y, m, 0);
+
+}
+
+// one persistent gradient buffer per layer, carved from a single allocation
+static int alloc_grads(Trainer *t){
+
+	u64 total = 0;
+	for (int l = 0; l < t->n_layers; l++)
+		total += (u64)t->layers[l].n_in * t->layers[l].n_out;
+
+	t->grads = malloc(t->n_layers * sizeof(double *));
+	if (!t->grads) return -1;
+
+	t->grads[0] = calloc(total, sizeof(double));
+	if (!t->grads[0]){
+
+		free(t->grads);
+		t->grads = NULL;
+		return -1;
+
+	}
+
+	for (int l = 1; l < t->n_layers; l++)
+		t->grads[l] = t->grads[l - 1] + t->layers[l - 1].n_in * t->layers[l - 1].n_out;
+
+	return 0;
+
+}
+
+int trainer_set_accumulation(Trainer *t, int steps){
+
+	if (steps < 1) return -1;
+
+	if (steps > 1 && !t->grads && alloc_grads(t) != 0) return -1;
+
+	t->accum_steps = steps;
+
+	return 0;
+
+}
+
+int trainer_set_checkpointing(Trainer *t, int every){
+
+	if (every < 1) return -1;
+	if (every == t->plan->checkpoint_every) return 0;
+
+	MemoryPlan *plan = memory_plan_create_checkpointed(t->layers, t->n_layers, t->batch_size, every);
+	if (!plan) return -1;
+
+	Arena *arena = arena_create(plan->total_bytes);
+	if (!arena){
+
+		memory_plan_destroy(plan);
+		return -1;
+
+	}
+
+	arena_destroy(t->arena);
+	memory_plan_destroy(t->plan);
+
+	t->plan = plan;
+	t->arena = arena;
+	t->base = arena_push(t->arena, t->plan->total_bytes);
+	t->x_batch = memory_plan_buffer(t->plan, t->base, t->plan->input);
+	t->y_batch = memory_plan_buffer(t->plan, t->base, t->plan->target);
+
+	return 0;
+
+}
+
+double train_accumulate(Trainer *t, double *x, double *y, int m){
+
+	// callers may accumulate without trainer_set_accumulation
+	if (!t->grads && alloc_grads(t) != 0) return NAN;
+
+	return run_step(t, x, y, m, 1);
+
+}
+
+void train_apply(Trainer *t){
+
+	if (t->accum_samples == 0 || !t->grads) return;
+
+	double scale = t->lr / t->accum_samples;
+
+	for (int l = 0; l < t->n_layers; l++){
+
+		DenseLayer *layer = &t->layers[l];
+		double *w = layer->weights;
+		double *dw = t->grads[l];
+		int n_w = layer->n_in * layer->n_out;
+
+		for (int i = 0; i < n_w; i++){
+
+			w[i] -= scale * dw[i];
+			dw[i] = 0.0;
+
+		}
+
+	}
+
+	t->accum_samples = 0;
+
+}
+
+EpochStats train_epoch(Trainer *t, BatchIterator *it){
+
+	EpochStats stats = {0};
+	double loss_sum = 0.0;
+
+	// the batch buffers hold t->batch_size rows; n_steps = -1 flags the mismatch
+	if (it->batch_size > t->batch_size){
+
+		stats.n_steps = -1;
+		return stats;
+
+	}
+
+	batch_iterator_shuffle(it);
+
+	double start = now_seconds();
+
+	int m;
+	int micro = 0;
+	while ((m = batch_iterator_next(it, t->x_batch, t->y_batch)) > 0){
+
+		stats.n_samples += m;
+
+		if (t->accum_steps <= 1){
+
+			loss_sum += train_step(t, t->x_batch, t->y_batch, m) * m;
+			stats.n_steps++;
+			continue;
+
+		}
+
+		loss_sum += train_accumulate(t, t->x_batch, t->y_batch, m) * m;
+
+		if (++micro == t->accum_steps){
+
+			train_apply(t);
+			stats.n_steps++;
+			micro = 0;
+
+		}
+
+	}
+
+	// a partial group at the end of the epoch still takes its step
+	if (micro > 0){
+
+		train_apply(t);
+		stats.n_steps++;
+
+	}
+
+	stats.seconds = now_seconds() - start;
+	stats.loss = stats.n_samples > 0 ? loss_sum / stats.n_samples : 0.0;
+	stats.samples_per_sec = stats.seconds > 0.0 ? stats.n_samples / stats.seconds : 0.0;
+
+	return stats;
+
+}
+
+void trainer_destroy(Trainer *t){
+
+	if (!t) return;
+
+	if (t->grads){
+
+		free(t->grads[0]);
+		free(t->grads);
+
+	}
+
+	arena_destroy(t->arena);
+	memory_plan_destroy(t->plan);
+	free(t);
+
+}
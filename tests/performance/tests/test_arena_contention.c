@@ -0,0 +1,117 @@
+/*
+ * OpenDI Arena Contention Benchmark
+ *
+ * Measures: push throughput of one shared ARENA_CONCURRENT arena (default and
+ * 128-byte alignment) against per-thread arenas and a mutex-guarded shared arena
+ */
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include <pthread.h>
+#include "../../../include/arena.h"
+
+#define PUSHES_PER_THREAD 2000000
+#define PUSH_SIZE 48
+#define MAX_THREADS 8
+
+/* Get high-resolution time in seconds */
+double get_time() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+typedef enum { MODE_PER_THREAD, MODE_SHARED, MODE_SHARED_128, MODE_MUTEX } Mode;
+
+typedef struct {
+    Mode mode;
+    Arena *shared;
+    Arena *own;
+    pthread_mutex_t *lock;
+    volatile u8 sink;
+} Job;
+
+void *run_job(void *arg) {
+    Job *job = arg;
+    u8 sink = 0;
+
+    for (int i = 0; i < PUSHES_PER_THREAD; i++) {
+        u8 *p = NULL;
+
+        switch (job->mode) {
+        case MODE_PER_THREAD:
+            p = arena_push(job->own, PUSH_SIZE);
+            break;
+        case MODE_SHARED:
+            p = arena_push(job->shared, PUSH_SIZE);
+            break;
+        case MODE_SHARED_128:
+            p = arena_push_aligned(job->shared, PUSH_SIZE, 128);
+            break;
+        case MODE_MUTEX:
+            pthread_mutex_lock(job->lock);
+            p = arena_push(job->shared, PUSH_SIZE);
+            pthread_mutex_unlock(job->lock);
+            break;
+        }
+
+        if (p) { p[0] = (u8)i; sink ^= p[0]; }
+    }
+
+    job->sink = sink;
+    return NULL;
+}
+
+double bench(Mode mode, int n_threads) {
+    u64 per_thread = (u64)PUSHES_PER_THREAD * 128;
+    Arena *shared = NULL;
+    Arena *own[MAX_THREADS] = {0};
+    pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+
+    if (mode == MODE_PER_THREAD) {
+        for (int t = 0; t < n_threads; t++) own[t] = arena_create(per_thread);
+    } else {
+        shared = arena_create_ex(per_thread * n_threads, mode == MODE_MUTEX ? 0 : ARENA_CONCURRENT);
+    }
+
+    pthread_t threads[MAX_THREADS];
+    Job jobs[MAX_THREADS];
+
+    double start = get_time();
+    for (int t = 0; t < n_threads; t++) {
+        jobs[t].mode = mode;
+        jobs[t].shared = shared;
+        jobs[t].own = own[t];
+        jobs[t].lock = &lock;
+        pthread_create(&threads[t], NULL, run_job, &jobs[t]);
+    }
+    for (int t = 0; t < n_threads; t++)
+        pthread_join(threads[t], NULL);
+    double elapsed = get_time() - start;
+
+    for (int t = 0; t < n_threads; t++) arena_destroy(own[t]);
+    arena_destroy(shared);
+
+    return (double)PUSHES_PER_THREAD * n_threads / elapsed / 1e6;
+}
+
+int main() {
+    printf("=== Arena Push Contention (M pushes/s, %d-byte pushes) ===\n\n", PUSH_SIZE);
+    printf("%-8s %-14s %-14s %-14s %-14s\n",
+           "Threads", "Per-thread", "Shared", "Shared 128B", "Mutex");
+    printf("%-8s %-14s %-14s %-14s %-14s\n",
+           "-------", "----------", "---------", "----------", "-----");
+
+    for (int n = 1; n <= MAX_THREADS; n *= 2) {
+        printf("%-8d %-14.1f %-14.1f %-14.1f %-14.1f\n", n,
+               bench(MODE_PER_THREAD, n),
+               bench(MODE_SHARED, n),
+               bench(MODE_SHARED_128, n),
+               bench(MODE_MUTEX, n));
+    }
+
+    return 0;
+}
@@ -22,18 +22,19 @@
  *     src/backward/activations/relu_backward.c \
  *     src/backward/activations/sigmoid_backward.c \
  *     src/backward/activations/softmax_backward.c \
+ *     src/arena/arena_scratch.c \
  *     src/backward/linalg/matmul_backward_a.c \
  *     src/backward/linalg/matmul_backward_b.c \
  *     src/optimizers/sgd_update.c \
  *     src/random/random_seed.c src/random/random_uniform.c \
- *     src/random/random_normal.c \
- *     src/statistics/normalize.c \
+ *     src/random/random_normal.c src/random/rng.c src/random/philox.c src/random/ziggurat.c \
+ *     src/statistics/normalize.c src/statistics/column_stats.c \
  *     src/pipeline/batch_relu.c src/pipeline/batch_sigmoid.c \
  *     src/pipeline/batch_softmax.c src/pipeline/batch_normalize.c \
  *     src/pipeline/mse_backward.c src/pipeline/cross_entropy_backward.c \
  *     src/pipeline/accuracy.c src/pipeline/init_weights.c \
  *     src/pipeline/dense_forward.c src/pipeline/dense_backward.c \
- *     -o test_bin/test_all_functions -lm
+ *     -o test_bin/test_all_functions -lm -lpthread
  */
 
 #include <stdio.h>
@@ -0,0 +1,97 @@
+#include <stdio.h>
+#include <string.h>
+#include "../../../include/arena.h"
+#include "../../../include/linalg/matricies/matmul.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int is_aligned(void *p, u64 align) {
+    return ((uintptr_t)p & (align - 1)) == 0;
+}
+
+int main() {
+    printf("=== Testing arena alignment ===\n\n");
+
+    // Test 1: default pushes are ALIGNMENT (64) aligned
+    Arena *arena = arena_create(65536);
+    int all = 1;
+    for (int i = 1; i < 40; i++)
+        if (!is_aligned(arena_push(arena, i * 3), 64)) all = 0;
+    check(ALIGNMENT == 64, "default alignment is 64 bytes");
+    check(all, "odd-sized pushes all start on 64-byte boundaries");
+
+    // Test 2: per-push alignment
+    arena_clear(arena);
+    char *c = arena_push_aligned(arena, 1, 1);
+    char *d = arena_push_aligned(arena, 1, 1);
+    check(d == c + 1, "alignment 1 packs bytes back to back");
+    check(is_aligned(arena_push_aligned(arena, 10, 4096), 4096), "alignment 4096 honoured");
+    check(is_aligned(arena_push_aligned(arena, 8, 16), 16), "alignment 16 honoured");
+    check(is_aligned(arena_push(arena, 8), 64), "default push after mixed alignments is 64 aligned");
+
+    // Test 3: kernel outputs are SIMD aligned
+    arena_clear(arena);
+    arena_push_aligned(arena, 3, 1);
+    double a[] = {1.0, 2.0, 3.0, 4.0};
+    double *r = matmul(arena, a, a, 2, 2, 2);
+    check(is_aligned(r, 64), "matmul output is 64-byte aligned");
+    arena_destroy(arena);
+
+    // Test 4: growable arenas keep alignment across blocks
+    arena = arena_create_ex(4096, ARENA_GROWABLE);
+    all = 1;
+    for (int i = 0; i < 200; i++) {
+        void *p = arena_push(arena, 100 + i);
+        if (!p || !is_aligned(p, 64)) all = 0;
+    }
+    void *big = arena_push_aligned(arena, 10000, 8192);
+    check(all, "growable arena pushes are 64 aligned across blocks");
+    check(big && is_aligned(big, 8192), "large alignment in a fresh block");
+    arena_destroy(arena);
+
+    // Test 5: huge-page backed fixed arena
+    u64 cap = 8ull * 1024 * 1024;
+    arena = arena_create_ex(cap, ARENA_HUGE_PAGES);
+    check(arena != NULL, "huge page arena created");
+    check(arena->capacity >= cap, "huge page arena holds the requested capacity");
+    double *buf = arena_push(arena, cap);
+    check(buf != NULL && is_aligned(buf, 64), "full-capacity push succeeds");
+    memset(buf, 0, cap);
+    buf[cap / sizeof(double) - 1] = 1.0;
+    check(buf[cap / sizeof(double) - 1] == 1.0, "huge page arena is writable to the end");
+#ifdef ARENA_HAS_VIRTUAL
+    check((arena->flags & ARENA_VIRTUAL) && is_aligned(arena, ARENA_HUGE_PAGE_SIZE),
+          "huge page arena is mapped on a huge page boundary");
+#endif
+    arena_destroy(arena);
+
+    // Test 6: explicit huge pages fall back when none are reserved
+    arena = arena_create_ex(cap, ARENA_HUGETLB);
+    check(arena != NULL && arena_push(arena, cap) != NULL, "ARENA_HUGETLB arena usable (hugetlbfs or fallback)");
+    arena_destroy(arena);
+
+    // Test 7: growable arena on transparent huge pages
+    arena = arena_create_ex(64ull * 1024 * 1024, ARENA_GROWABLE | ARENA_HUGE_PAGES);
+    double *g = arena_push(arena, 5ull * 1024 * 1024);
+    check(g != NULL, "growable huge page arena commits on demand");
+    g[5 * 1024 * 1024 / sizeof(double) - 1] = 2.0;
+    check(g[5 * 1024 * 1024 / sizeof(double) - 1] == 2.0, "committed huge pages are writable");
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
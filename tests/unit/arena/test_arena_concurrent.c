@@ -0,0 +1,178 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "../../../include/arena.h"
+
+#define N_THREADS 8
+#define N_PUSHES 20000
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+typedef struct {
+    Arena *arena;
+    int id;
+    int big_align;
+    int oversize;
+    int n_ok;
+    int oversize_ok;
+    u64 bytes;
+    u8 **ptrs;
+    u32 *sizes;
+} Worker;
+
+// per-thread xorshift32 for push sizes; rand() is not thread-safe and rand_r is not C99
+static u32 xorshift32(u32 *state) {
+    u32 x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+void *push_worker(void *arg) {
+    Worker *w = arg;
+    u32 seed = 1234u + w->id;
+    w->n_ok = 0;
+    w->oversize_ok = 0;
+    w->bytes = 0;
+    for (int i = 0; i < N_PUSHES; i++) {
+        // a request larger than the whole arena must fail without taking space
+        if (w->oversize && i % 3 == 0) {
+            if (arena_push(w->arena, w->arena->capacity + 1) != NULL) w->oversize_ok++;
+            continue;
+        }
+        u32 size = 1 + xorshift32(&seed) % 200;
+        u64 align = (w->big_align && i % 7 == 0) ? 256 : ALIGNMENT;
+        u8 *p = arena_push_aligned(w->arena, size, align);
+        if (!p) continue;
+        memset(p, w->id + 1, size);
+        w->ptrs[w->n_ok] = p;
+        w->sizes[w->n_ok] = size;
+        w->n_ok++;
+        w->bytes += arena_align_up(size, align);
+    }
+    return NULL;
+}
+
+int cmp_ptr(const void *a, const void *b) {
+    const u8 *const *x = a;
+    const u8 *const *y = b;
+    return (*x > *y) - (*x < *y);
+}
+
+// runs N_THREADS workers, then checks every block is intact, aligned and disjoint
+int run_and_verify(Arena *arena, int big_align, int oversize, Worker *workers, u64 *total_bytes, int *n_total) {
+    pthread_t threads[N_THREADS];
+    for (int t = 0; t < N_THREADS; t++) {
+        workers[t].arena = arena;
+        workers[t].id = t;
+        workers[t].big_align = big_align;
+        workers[t].oversize = oversize;
+        pthread_create(&threads[t], NULL, push_worker, &workers[t]);
+    }
+    for (int t = 0; t < N_THREADS; t++)
+        pthread_join(threads[t], NULL);
+
+    int ok = 1;
+    *total_bytes = 0;
+    *n_total = 0;
+
+    u8 **all = malloc((size_t)N_THREADS * N_PUSHES * 2 * sizeof(u8 *));
+    for (int t = 0; t < N_THREADS; t++) {
+        *total_bytes += workers[t].bytes;
+        if (workers[t].oversize_ok) ok = 0;
+        for (int i = 0; i < workers[t].n_ok; i++) {
+            u8 *p = workers[t].ptrs[i];
+            u32 size = workers[t].sizes[i];
+            if ((uintptr_t)p % ALIGNMENT != 0) ok = 0;
+            if (p + size > (u8 *)arena + ARENA_HEADER_SIZE + arena->capacity) ok = 0;
+            for (u32 k = 0; k < size; k++)
+                if (p[k] != (u8)(t + 1)) { ok = 0; break; }
+            all[2 * *n_total] = p;
+            all[2 * *n_total + 1] = p + size;
+            (*n_total)++;
+        }
+    }
+
+    // sort block [start, end) pairs by start and check neighbours are disjoint
+    qsort(all, *n_total, 2 * sizeof(u8 *), cmp_ptr);
+    for (int i = 1; i < *n_total; i++)
+        if (all[2 * i] < all[2 * (i - 1) + 1]) ok = 0;
+
+    free(all);
+    return ok;
+}
+
+int main() {
+    printf("=== Testing concurrent arena ===\n\n");
+
+    Worker workers[N_THREADS];
+    for (int t = 0; t < N_THREADS; t++) {
+        workers[t].ptrs = malloc(N_PUSHES * sizeof(u8 *));
+        workers[t].sizes = malloc(N_PUSHES * sizeof(u32));
+    }
+
+    u64 total;
+    int n;
+
+    // Test 1: many threads pushing into one arena get disjoint, intact blocks
+    Arena *arena = arena_create_ex(64ull * 1024 * 1024, ARENA_CONCURRENT);
+    check(arena != NULL && (arena->flags & ARENA_CONCURRENT), "concurrent arena created");
+
+    int ok = run_and_verify(arena, 0, 0, workers, &total, &n);
+    check(n == N_THREADS * N_PUSHES, "every push succeeds when the arena is large enough");
+    check(ok, "blocks are aligned, disjoint and intact");
+    check(arena_pos(arena) - ARENA_HEADER_SIZE == total, "no bytes lost: position equals the sum of pushes");
+
+    // Test 2: mixed alignments take the CAS path and still never overlap
+    arena_clear(arena);
+    ok = run_and_verify(arena, 1, 0, workers, &total, &n);
+    check(n == N_THREADS * N_PUSHES, "mixed-alignment pushes all succeed");
+    check(ok, "mixed-alignment blocks are disjoint and intact");
+    arena_destroy(arena);
+
+    // Test 3: overflow under contention never hands out memory past the end
+    arena = arena_create_ex(256 * 1024, ARENA_CONCURRENT);
+    ok = run_and_verify(arena, 1, 0, workers, &total, &n);
+    check(n > 0 && n < N_THREADS * N_PUSHES, "pushes fail once the arena is full");
+    check(ok, "blocks handed out before overflow stay within capacity");
+    check(total <= arena->capacity, "successful pushes fit in the capacity");
+    arena_destroy(arena);
+
+    // Test 4: oversized pushes mixed with small ones never strand free space
+    arena = arena_create_ex(256 * 1024, ARENA_CONCURRENT);
+    ok = run_and_verify(arena, 0, 1, workers, &total, &n);
+    check(ok, "oversized pushes fail and small blocks stay disjoint and intact");
+    check(arena_pos(arena) - ARENA_HEADER_SIZE == total, "failed pushes leave the position untouched");
+    check(arena->capacity - total < 256, "small pushes fill the arena up to the last block");
+    arena_destroy(arena);
+
+    // Test 5: concurrent arenas are always fixed
+    arena = arena_create_ex(4096, ARENA_CONCURRENT | ARENA_GROWABLE);
+    check(arena != NULL && !(arena->flags & ARENA_GROWABLE), "ARENA_GROWABLE is dropped for concurrent arenas");
+    check(arena_push(arena, 8192) == NULL, "concurrent arena does not grow");
+    arena_destroy(arena);
+
+    for (int t = 0; t < N_THREADS; t++) {
+        free(workers[t].ptrs);
+        free(workers[t].sizes);
+    }
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,89 @@
+//strict POSIX hides MAP_ANONYMOUS, so this TU cannot create mappings - it must still
+//commit and release the ones created by the library TUs it links against
+#define _POSIX_C_SOURCE 199309L
+#include <stdio.h>
+#include "../../../include/arena.h"
+#include "../../../include/linalg/vectors/vecscale.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+//resident set size in MB, -1 where /proc is not available
+static long rss_mb(void) {
+    long pages = -1, resident = -1;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return -1;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = -1;
+    fclose(f);
+    return resident < 0 ? -1 : resident * 4096 / (1024 * 1024);
+}
+
+int main() {
+    printf("=== Testing arena blocks across translation units ===\n\n");
+
+    size_t n = 4 * 1024 * 1024 / sizeof(double);
+    double *src = malloc(n * sizeof(double));
+    for (size_t i = 0; i < n; i++) src[i] = (double)i;
+
+    // Test 1: this TU creates a malloc block, vecscale.c chains blocks onto it
+    Arena *arena = arena_create_ex(0, ARENA_GROWABLE);
+    check(arena != NULL, "growable arena created under _POSIX_C_SOURCE");
+#ifndef ARENA_HAS_VIRTUAL
+    check(!(arena->flags & ARENA_VIRTUAL), "this TU falls back to malloc blocks");
+#endif
+
+    double *out = vecscale(arena, src, 2.0, n);
+    check(out != NULL && out[n - 1] == 2.0 * (double)(n - 1), "push from another TU chains a block");
+#ifdef ARENA_HAS_MMAN
+    check(arena->current->flags & ARENA_VIRTUAL, "the chained block is a mapping");
+#endif
+
+    // Test 2: clearing here releases the mapped blocks instead of leaking them
+    arena_clear(arena);
+    check(arena->current == arena, "arena_clear unwinds to the first block");
+
+    long before = rss_mb();
+    int ok = 1;
+    for (int step = 0; step < 100 && ok; step++) {
+        ok = vecscale(arena, src, 0.5, n) != NULL && vecscale(arena, src, 0.25, n) != NULL;
+        arena_clear(arena);
+    }
+    long after = rss_mb();
+    check(ok, "100 push/clear cycles succeed");
+    check(before < 0 || after - before < 64, "resident memory stays flat over push/clear cycles");
+
+    arena_destroy(arena);
+
+    // Test 3: a block mapped in arena_scratch.c commits pages when pushed from here
+    ArenaTemp scratch = arena_scratch_begin(NULL, 0);
+    Arena *s = scratch.arena;
+    Arena *block = s->current;
+    u64 *big = arena_push(s, 8 * 1024 * 1024);
+    check(big != NULL, "push past the committed pages of a scratch arena");
+    if (block->flags & ARENA_VIRTUAL)
+        check(s->current == block, "pages are committed in place rather than chaining a block");
+    if (big) {
+        big[0] = 1;
+        big[8 * 1024 * 1024 / 8 - 1] = 2;
+        check(big[0] == 1 && big[8 * 1024 * 1024 / 8 - 1] == 2, "committed pages are writable to the end");
+    }
+    arena_scratch_end(scratch);
+
+    free(src);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,81 @@
+#include <stdio.h>
+#include "../../../include/arena.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing growable arena ===\n\n");
+
+    // Test 1: fixed arenas still fail on overflow
+    Arena *fixed = arena_create(256);
+    check(arena_push(fixed, 200) != NULL, "fixed arena push within capacity");
+    check(arena_push(fixed, 200) == NULL, "fixed arena push past capacity returns NULL");
+    arena_destroy(fixed);
+
+    // Test 2: growable arena commits on demand, pointers stay put
+    Arena *arena = arena_create_ex(1024 * 1024, ARENA_GROWABLE);
+    check(arena != NULL, "arena_create_ex returns growable arena");
+#ifdef ARENA_HAS_VIRTUAL
+    check(arena->flags & ARENA_VIRTUAL, "growable arena is backed by reserved virtual memory");
+#endif
+
+    int n_bufs = 64;
+    u64 *bufs[64];
+    int stable = 1;
+    for (int i = 0; i < n_bufs; i++) {
+        bufs[i] = arena_push(arena, 100 * 1024);
+        if (!bufs[i]) { stable = 0; break; }
+        for (int j = 0; j < 100 * 1024 / 8; j++) bufs[i][j] = (u64)i * 1000003u + j;
+    }
+    check(stable, "6.4 MB of pushes succeed on a 1 MB-per-block arena");
+
+    for (int i = 0; i < n_bufs && stable; i++)
+        for (int j = 0; j < 100 * 1024 / 8; j++)
+            if (bufs[i][j] != (u64)i * 1000003u + j) stable = 0;
+    check(stable, "earlier buffers are intact after growth");
+    check(arena->current != arena, "growth past the reservation chains a new block");
+
+    // Test 3: positions are global and monotonic across blocks
+    u64 before = arena_pos(arena);
+    void *p = arena_push(arena, 64);
+    check(p != NULL && arena_pos(arena) == before + 64, "arena_pos advances by the pushed size");
+
+    // Test 4: a single push larger than the block reservation
+    u64 *huge = arena_push(arena, 3 * 1024 * 1024);
+    check(huge != NULL, "oversized push gets its own block");
+    huge[3 * 1024 * 1024 / 8 - 1] = 42;
+    check(huge[3 * 1024 * 1024 / 8 - 1] == 42, "oversized block is writable to the end");
+
+    // Test 5: temp scopes and pop_to unwind across blocks
+    ArenaTemp temp = arena_temp_begin(arena);
+    for (int i = 0; i < 20; i++) arena_push(arena, 512 * 1024);
+    arena_temp_end(temp);
+    check(arena_pos(arena) == temp.position, "arena_temp_end unwinds across chained blocks");
+
+    arena_pop_to(arena, ARENA_HEADER_SIZE + 1024);
+    check(arena_pos(arena) == ARENA_HEADER_SIZE + 1024, "arena_pop_to lands inside the first block");
+    check(arena->current == arena, "blocks above the target are released");
+
+    arena_clear(arena);
+    check(arena_pos(arena) == ARENA_HEADER_SIZE, "arena_clear resets to the header");
+    check(arena_push(arena, 8) == (u8 *)arena + ARENA_HEADER_SIZE, "first push after clear reuses the first block");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
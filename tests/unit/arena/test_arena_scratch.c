@@ -0,0 +1,112 @@
+#include <stdio.h>
+#include <math.h>
+#include <pthread.h>
+#include "../../../include/arena.h"
+#include "../../../include/backward/linalg/matmul_backward_a.h"
+#include "../../../include/backward/linalg/matmul_backward_b.h"
+#include "../../../include/pipeline/batch_normalize.h"
+#include "../../../include/pipeline/dense_backward.h"
+
+#define EPSILON 1e-10
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+void *thread_scratch(void *arg) {
+    ArenaTemp temp = arena_scratch_begin(NULL, 0);
+    *(Arena **)arg = temp.arena;
+    arena_scratch_end(temp);
+    arena_scratch_release();
+    return NULL;
+}
+
+int main() {
+    printf("=== Testing arena scratch ===\n\n");
+
+    Arena *arena = arena_create(65536);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    // Test 1: temp scope restores the position
+    u64 start = arena->position;
+    ArenaTemp temp = arena_temp_begin(arena);
+    arena_push(arena, 1000);
+    arena_push(arena, 24);
+    arena_temp_end(temp);
+    check(arena->position == start, "arena_temp_end pops back to begin position");
+
+    // Test 2: scratch arena avoids conflicts
+    ArenaTemp s1 = arena_scratch_begin(&arena, 1);
+    check(s1.arena != NULL && s1.arena != arena, "scratch arena differs from caller arena");
+
+    ArenaTemp s2 = arena_scratch_begin(&s1.arena, 1);
+    check(s2.arena != NULL && s2.arena != s1.arena, "conflicting scratch arena is skipped");
+
+    arena_push(s1.arena, 512);
+    u64 s1_pos = arena_pos(s1.arena);
+    arena_scratch_end(s2);
+    check(arena_pos(s1.arena) == s1_pos, "ending one scratch scope leaves the other alone");
+    arena_scratch_end(s1);
+    check(arena_pos(s1.arena) == s1.position, "scratch scope releases its temporaries");
+
+    // Test 3: kernels leave only their outputs on the caller arena
+    double a[6] = {1, 2, 3, 4, 5, 6};       // 2x3
+    double w[3] = {0.5, -1.0, 2.0};        // 3x1
+    double dout[2] = {1.0, -1.0};          // 2x1
+
+    u64 before = arena->position;
+    double *da = matmul_backward_a(arena, dout, w, 2, 3, 1);
+    check(arena->position - before == arena_align_up(6 * sizeof(double), ALIGNMENT), "matmul_backward_a pushes only its 2x3 output");
+    check(fabs(da[0] - 0.5) < EPSILON && fabs(da[5] + 2.0) < EPSILON, "matmul_backward_a values unchanged");
+
+    before = arena->position;
+    double *db = matmul_backward_b(arena, a, dout, 2, 3, 1);
+    check(arena->position - before == arena_align_up(3 * sizeof(double), ALIGNMENT), "matmul_backward_b pushes only its 3x1 output");
+    check(fabs(db[0] + 3.0) < EPSILON && fabs(db[2] + 3.0) < EPSILON, "matmul_backward_b values unchanged");
+
+    before = arena->position;
+    double *bn = batch_normalize(arena, a, 2, 3);
+    check(arena->position - before == arena_align_up(6 * sizeof(double), ALIGNMENT), "batch_normalize pushes only its output");
+    check(fabs(bn[0] + 1.0) < EPSILON && fabs(bn[3] - 1.0) < EPSILON, "batch_normalize values unchanged");
+
+    double cache[2] = {1.0, -1.0};
+    before = arena->position;
+    LayerGrad g = dense_backward(arena, dout, a, w, cache, 2, 3, 1, ACTIVATION_RELU);
+    check(arena->position - before == arena_align_up(3 * sizeof(double), ALIGNMENT) + arena_align_up(6 * sizeof(double), ALIGNMENT), "dense_backward keeps d_act off the caller arena");
+    check(fabs(g.d_weights[0] - 1.0) < EPSILON && fabs(g.d_input[5]) < EPSILON, "dense_backward values unchanged");
+
+    // Test 4: kernels still work when the caller arena is a scratch arena
+    ArenaTemp outer = arena_scratch_begin(NULL, 0);
+    da = matmul_backward_a(outer.arena, dout, w, 2, 3, 1);
+    check(fabs(da[1] + 1.0) < EPSILON, "kernel output on a scratch arena is intact");
+    arena_scratch_end(outer);
+
+    // Test 5: scratch arenas are per thread
+    Arena *mine = arena_scratch_begin(NULL, 0).arena;
+    Arena *theirs = NULL;
+    pthread_t thread;
+    pthread_create(&thread, NULL, thread_scratch, &theirs);
+    pthread_join(thread, NULL);
+    check(theirs != NULL && theirs != mine, "each thread gets its own scratch arena");
+
+    arena_scratch_release();
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
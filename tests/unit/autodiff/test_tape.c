@@ -0,0 +1,98 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/autodiff/tape.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing tape ===\n\n");
+
+    Arena *arena = arena_create(1 << 20);
+    Tape *tape = tape_create(arena);
+    check(tape != NULL, "tape_create returns tape");
+
+    // Test 1: forward ops compute their values eagerly
+    double xd[] = {1.0, -2.0, 3.0, 4.0};   // 2x2
+    double wd[] = {0.5, -1.0, 2.0, 0.0};   // 2x2
+    double bd[] = {1.0, -1.0};             // 1x2
+
+    int x = tape_input(tape, xd, 2, 2);
+    int w = tape_param(tape, wd, 2, 2);
+    int b = tape_param(tape, bd, 1, 2);
+    int z = tape_matmul(tape, x, w);
+    int zb = tape_add(tape, z, b);
+    int h = tape_relu(tape, zb);
+
+    double *zv = tape_value(tape, z);
+    // [1 -2; 3 4] @ [0.5 -1; 2 0] = [-3.5 -1; 9.5 -3]
+    check(fabs(zv[0] + 3.5) < EPSILON && fabs(zv[1] + 1.0) < EPSILON &&
+          fabs(zv[2] - 9.5) < EPSILON && fabs(zv[3] + 3.0) < EPSILON, "matmul value");
+
+    double *hv = tape_value(tape, h);
+    check(hv[0] == 0.0 && fabs(hv[1]) < EPSILON && fabs(hv[2] - 10.5) < EPSILON && hv[3] == 0.0,
+          "bias broadcast and relu values");
+
+    check(tape_value(tape, x) == xd && tape_value(tape, w) == wd, "leaves alias caller data");
+    check(tape->nodes[x].requires_grad == 0 && tape->nodes[h].requires_grad == 1,
+          "requires_grad flows from params");
+
+    // Test 2: shape errors return -1
+    double bad[3] = {0};
+    int v3 = tape_input(tape, bad, 3, 1);
+    check(tape_matmul(tape, x, v3) == -1, "matmul shape mismatch rejected");
+    check(tape_add(tape, x, v3) == -1, "add shape mismatch rejected");
+    check(tape_relu(tape, 999) == -1, "invalid node id rejected");
+
+    // Test 3: softmax rows sum to 1; losses are scalars
+    int s = tape_softmax(tape, zb);
+    double *sv = tape_value(tape, s);
+    check(fabs(sv[0] + sv[1] - 1.0) < EPSILON && fabs(sv[2] + sv[3] - 1.0) < EPSILON, "softmax rows sum to 1");
+
+    double td[] = {1.0, 0.0, 0.0, 1.0};
+    int t = tape_input(tape, td, 2, 2);
+    int ce = tape_softmax_cross_entropy(tape, zb, t);
+    int ce2 = tape_cross_entropy(tape, s, t);
+    check(tape->nodes[ce].rows == 1 && tape->nodes[ce].cols == 1, "loss node is 1x1");
+    check(fabs(tape_value(tape, ce)[0] - tape_value(tape, ce2)[0]) < 1e-9,
+          "fused softmax cross-entropy matches softmax then cross-entropy");
+
+    // Test 4: free list reuses a freed block of the right size
+    u64 size;
+    double *p1 = tape_alloc(tape, 100 * sizeof(double), &size);
+    u64 in_use = tape->bytes_in_use;
+    tape_free(tape, p1, size);
+    check(tape->bytes_in_use == in_use - size, "tape_free returns bytes");
+    u64 size2;
+    double *p2 = tape_alloc(tape, 90 * sizeof(double), &size2);
+    check(p2 == p1 && size2 == size, "tape_alloc reuses a freed block");
+    double *p3 = tape_alloc(tape, 8, &size);
+    check(p3 != p1, "small allocation does not take a much larger block");
+
+    // Test 5: reset rewinds the arena
+    u64 before = arena_pos(arena);
+    tape_reset(tape);
+    check(tape->n_nodes == 0 && arena_pos(arena) < before, "tape_reset clears nodes and arena");
+
+    tape_destroy(tape);
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
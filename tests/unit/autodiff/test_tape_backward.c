@@ -0,0 +1,131 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/autodiff/tape.h"
+#include "../../../include/arena.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+// 3x4 input, params W1 4x5, b1 1x5, W2 5x3, a 3x3 gate, exercising every op
+double xd[12], w1[20], b1[5], w2[15], gd[9], td[9];
+
+double build(Tape *tape, int kind, int *params) {
+    int x = tape_input(tape, xd, 3, 4);
+    int t = tape_input(tape, td, 3, 3);
+    int W1 = tape_param(tape, w1, 4, 5);
+    int B1 = tape_param(tape, b1, 1, 5);
+    int W2 = tape_param(tape, w2, 5, 3);
+    int G = tape_param(tape, gd, 3, 3);
+
+    int h = tape_tanh(tape, tape_add(tape, tape_matmul(tape, x, W1), B1));
+    int r = tape_relu(tape, tape_sub(tape, h, tape_scale(tape, h, 0.3)));
+    int o = tape_matmul(tape, r, W2);
+    o = tape_mul(tape, o, tape_sigmoid(tape, G));
+
+    int loss;
+    if (kind == 0) loss = tape_mse(tape, o, t);
+    else if (kind == 1) loss = tape_cross_entropy(tape, tape_softmax(tape, o), t);
+    else loss = tape_softmax_cross_entropy(tape, o, t);
+
+    params[0] = W1; params[1] = B1; params[2] = W2; params[3] = G;
+    return loss;
+}
+
+int main() {
+    printf("=== Testing tape_backward ===\n\n");
+
+    for (int i = 0; i < 12; i++) xd[i] = sin(1.3 * i);
+    for (int i = 0; i < 20; i++) w1[i] = cos(0.7 * i) * 0.8;
+    for (int i = 0; i < 5; i++) b1[i] = 0.1 * i - 0.2;
+    for (int i = 0; i < 15; i++) w2[i] = sin(0.9 * i + 0.4);
+    for (int i = 0; i < 9; i++) gd[i] = 0.2 * i - 0.8;
+    for (int i = 0; i < 9; i++) td[i] = (i % 4 == 0) ? 1.0 : 0.0;
+
+    double *param_data[] = {w1, b1, w2, gd};
+    int param_size[] = {20, 5, 15, 9};
+    const char *names[] = {"mse", "softmax + cross_entropy", "softmax_cross_entropy"};
+
+    Arena *arena = arena_create(1 << 20);
+    Tape *tape = tape_create(arena);
+
+    // Test 1: gradients match central finite differences for every param
+    for (int kind = 0; kind < 3; kind++) {
+        int params[4];
+        tape_reset(tape);
+        int loss = build(tape, kind, params);
+        check(tape_backward(tape, loss) == 0, "tape_backward succeeds");
+
+        double max_err = 0.0;
+        for (int p = 0; p < 4; p++) {
+            double *grad = tape_grad(tape, params[p]);
+            for (int i = 0; i < param_size[p]; i++) {
+                double keep = param_data[p][i];
+                double h = 1e-6;
+                int dummy[4];
+
+                param_data[p][i] = keep + h;
+                Tape *probe = tape_create(arena_create(1 << 20));
+                double up = tape_value(probe, build(probe, kind, dummy))[0];
+                arena_destroy(probe->arena);
+                tape_destroy(probe);
+
+                param_data[p][i] = keep - h;
+                probe = tape_create(arena_create(1 << 20));
+                double down = tape_value(probe, build(probe, kind, dummy))[0];
+                arena_destroy(probe->arena);
+                tape_destroy(probe);
+
+                param_data[p][i] = keep;
+
+                double err = fabs(grad[i] - (up - down) / (2 * h));
+                if (err > max_err) max_err = err;
+            }
+        }
+
+        char name[96];
+        snprintf(name, sizeof(name), "%s: gradients match finite differences", names[kind]);
+        check(max_err < 1e-6, name);
+    }
+
+    // Test 2: backward frees intermediates and keeps only param grads and the loss
+    int params[4];
+    tape_reset(tape);
+    int loss = build(tape, 2, params);
+    u64 forward_bytes = tape->bytes_in_use;
+    tape_backward(tape, loss);
+
+    check(tape_value(tape, loss) != NULL, "loss value survives backward");
+    check(tape_value(tape, loss - 1) == NULL, "intermediate values are released");
+    check(tape->bytes_in_use < forward_bytes, "memory in use drops after backward");
+
+    u64 kept = 0;
+    for (int p = 0; p < 4; p++) kept += tape->nodes[params[p]].grad_bytes;
+    kept += tape->nodes[loss].value_bytes;
+    check(tape->bytes_in_use == kept, "only param grads and the loss remain");
+    check(tape->peak_bytes < 2 * forward_bytes, "peak stays below values plus all gradients");
+
+    // Test 3: backward from a non-scalar node is rejected
+    tape_reset(tape);
+    int x = tape_input(tape, xd, 3, 4);
+    int W1 = tape_param(tape, w1, 4, 5);
+    check(tape_backward(tape, tape_matmul(tape, x, W1)) == -1, "non-scalar loss rejected");
+
+    tape_destroy(tape);
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,168 @@
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "../../../include/autodiff/tape_plan.h"
+#include "../../../include/arena.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+#define MAX_ROWS 400
+
+// rows x 4 input, params W1 4x5, b1 1x5, W2 5x3, a rows x 3 gate, exercising every op
+double xd[MAX_ROWS * 4], td[MAX_ROWS * 3];
+double w1[20], b1[5], w2[15], gd[MAX_ROWS * 3];
+
+int build(Tape *tape, int kind, int rows, int *params) {
+    int x = tape_input(tape, xd, rows, 4);
+    int t = tape_input(tape, td, rows, 3);
+    int W1 = tape_param(tape, w1, 4, 5);
+    int B1 = tape_param(tape, b1, 1, 5);
+    int W2 = tape_param(tape, w2, 5, 3);
+    int G = tape_param(tape, gd, rows, 3);
+
+    int h = tape_tanh(tape, tape_add(tape, tape_matmul(tape, x, W1), B1));
+    int r = tape_relu(tape, tape_sub(tape, h, tape_scale(tape, h, 0.3)));
+    int o = tape_matmul(tape, r, W2);
+    o = tape_mul(tape, o, tape_sigmoid(tape, G));
+
+    if (params) {
+        params[0] = W1; params[1] = B1; params[2] = W2; params[3] = G;
+    }
+
+    if (kind == 0) return tape_mse(tape, o, t);
+    if (kind == 1) return tape_cross_entropy(tape, tape_softmax(tape, o), t);
+    return tape_softmax_cross_entropy(tape, o, t);
+}
+
+void init(int rows) {
+    for (int i = 0; i < rows * 4; i++) xd[i] = sin(1.3 * i);
+    for (int i = 0; i < 20; i++) w1[i] = cos(0.7 * i) * 0.8;
+    for (int i = 0; i < 5; i++) b1[i] = 0.1 * i - 0.2;
+    for (int i = 0; i < 15; i++) w2[i] = sin(0.9 * i + 0.4);
+    for (int i = 0; i < rows * 3; i++) gd[i] = 0.2 * (i % 9) - 0.8;
+    for (int i = 0; i < rows * 3; i++) td[i] = (i % 4 == 0) ? 1.0 : 0.0;
+}
+
+// one step of the unfused tape: record, backward, then plain SGD
+double reference_step(Arena *arena, int kind, int rows, double lr) {
+    double *data[] = {w1, b1, w2, gd};
+    int size[] = {20, 5, 15, rows * 3};
+    int params[4];
+
+    Tape *tape = tape_create(arena);
+    int loss = build(tape, kind, rows, params);
+    double value = tape_value(tape, loss)[0];
+    tape_backward(tape, loss);
+
+    for (int p = 0; p < 4; p++) {
+        double *grad = tape_grad(tape, params[p]);
+        for (int i = 0; i < size[p]; i++) data[p][i] -= lr * grad[i];
+    }
+
+    tape_reset(tape);
+    tape_destroy(tape);
+    return value;
+}
+
+// runs steps of the reference and of the plan from the same start and
+// compares losses and final parameters
+double compare(Arena *arena, int kind, int rows, int steps, int shift_inputs) {
+    double lr = 0.1;
+    double ref_loss[8], plan_loss[8];
+    double ref_w1[20], ref_b1[5], ref_w2[15], ref_gd[MAX_ROWS * 3];
+
+    init(rows);
+    for (int s = 0; s < steps; s++) {
+        if (shift_inputs) for (int i = 0; i < rows * 4; i++) xd[i] = sin(1.3 * i + s);
+        ref_loss[s] = reference_step(arena, kind, rows, lr);
+    }
+    memcpy(ref_w1, w1, sizeof(w1));
+    memcpy(ref_b1, b1, sizeof(b1));
+    memcpy(ref_w2, w2, sizeof(w2));
+    memcpy(ref_gd, gd, sizeof(double) * rows * 3);
+
+    init(rows);
+    Tape *tape = tape_create(arena);
+    TapePlan *plan = tape_plan_compile(tape, build(tape, kind, rows, NULL), lr);
+    tape_reset(tape);
+    tape_destroy(tape);
+    if (!plan) return 1e9;
+
+    for (int s = 0; s < steps; s++) {
+        if (shift_inputs) for (int i = 0; i < rows * 4; i++) xd[i] = sin(1.3 * i + s);
+        plan_loss[s] = tape_plan_run(plan);
+    }
+    tape_plan_destroy(plan);
+
+    double max_err = 0.0;
+    for (int s = 0; s < steps; s++) max_err = fmax(max_err, fabs(ref_loss[s] - plan_loss[s]));
+    for (int i = 0; i < 20; i++) max_err = fmax(max_err, fabs(ref_w1[i] - w1[i]));
+    for (int i = 0; i < 5; i++) max_err = fmax(max_err, fabs(ref_b1[i] - b1[i]));
+    for (int i = 0; i < 15; i++) max_err = fmax(max_err, fabs(ref_w2[i] - w2[i]));
+    for (int i = 0; i < rows * 3; i++) max_err = fmax(max_err, fabs(ref_gd[i] - gd[i]));
+
+    return max_err;
+}
+
+int main() {
+    printf("=== Testing tape_plan ===\n\n");
+
+    const char *names[] = {"mse", "softmax + cross_entropy", "softmax_cross_entropy"};
+    Arena *arena = arena_create(1 << 22);
+
+    // Test 1: replaying the fused plan matches the tape step for step
+    for (int kind = 0; kind < 3; kind++) {
+        char name[96];
+        snprintf(name, sizeof(name), "%s: fused replay matches tape + SGD", names[kind]);
+        check(compare(arena, kind, 3, 5, 0) < 1e-12, name);
+    }
+
+    // Test 2: batches taller than one tile are split into row tiles
+    check(compare(arena, 2, MAX_ROWS, 3, 0) < 1e-12, "multi-tile batch matches tape + SGD");
+
+    // Test 3: new data in the bound input buffers is picked up on replay
+    check(compare(arena, 0, 3, 5, 1) < 1e-12, "replay reads fresh input data");
+
+    // Test 4: chains are fused and only values backward reads are stored
+    init(3);
+    Tape *tape = tape_create(arena);
+    int loss = build(tape, 0, 3, NULL);
+    int n_ops = loss + 1 - 6;
+    TapePlan *plan = tape_plan_compile(tape, loss, 0.1);
+    check(plan != NULL, "compile succeeds");
+    check(plan->n_groups < n_ops, "fewer passes than recorded ops");
+    check(tape_plan_value(plan, 7) == NULL, "pre-activation stays in the tile");
+    check(tape_plan_value(plan, loss) != NULL, "loss value is stored");
+
+    double first = tape_plan_run(plan);
+    double last = first;
+    for (int s = 0; s < 50; s++) last = tape_plan_run(plan);
+    check(last < first, "replayed steps reduce the loss");
+    tape_plan_destroy(plan);
+
+    // Test 5: a non-loss node is rejected
+    tape_reset(tape);
+    int x = tape_input(tape, xd, 3, 4);
+    int W1 = tape_param(tape, w1, 4, 5);
+    check(tape_plan_compile(tape, tape_matmul(tape, x, W1), 0.1) == NULL, "non-loss node rejected");
+
+    tape_destroy(tape);
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
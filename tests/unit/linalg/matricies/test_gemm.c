@@ -0,0 +1,85 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../../include/linalg/matricies/gemm.h"
+#include "../../../../include/linalg/matricies/matmul.h"
+#include "../../../../include/linalg/matricies/mattranspose.h"
+#include "../../../../include/arena.h"
+
+#define EPSILON 1e-10
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int close_all(double *x, double *y, int n) {
+    for (int i = 0; i < n; i++)
+        if (fabs(x[i] - y[i]) > EPSILON) return 0;
+    return 1;
+}
+
+int main() {
+    printf("=== Testing gemm ===\n\n");
+
+    Arena *arena = arena_create(65536);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    // a is 3x4, b is 4x2
+    double a[12], b[8];
+    for (int i = 0; i < 12; i++) a[i] = 0.5 * i - 2.0;
+    for (int i = 0; i < 8; i++) b[i] = 1.0 - 0.25 * i;
+
+    double *ref = matmul(arena, a, b, 3, 4, 2);
+    double *at = mattranspose(arena, a, 3, 4);
+    double *bt = mattranspose(arena, b, 4, 2);
+
+    // Test 1: all four transpose combinations match matmul
+    double c[6];
+    gemm(c, a, b, 3, 4, 2, 0, 0, 1.0, 0.0);
+    check(close_all(c, ref, 6), "gemm NN matches matmul");
+
+    gemm(c, at, b, 3, 4, 2, 1, 0, 1.0, 0.0);
+    check(close_all(c, ref, 6), "gemm TN matches matmul");
+
+    gemm(c, a, bt, 3, 4, 2, 0, 1, 1.0, 0.0);
+    check(close_all(c, ref, 6), "gemm NT matches matmul");
+
+    gemm(c, at, bt, 3, 4, 2, 1, 1, 1.0, 0.0);
+    check(close_all(c, ref, 6), "gemm TT matches matmul");
+
+    // Test 2: beta = 0 ignores garbage in c
+    double nan_c[6];
+    for (int i = 0; i < 6; i++) nan_c[i] = NAN;
+    gemm(nan_c, a, b, 3, 4, 2, 0, 0, 1.0, 0.0);
+    check(close_all(nan_c, ref, 6), "beta = 0 overwrites c");
+
+    // Test 3: alpha and beta = 1 accumulate
+    double acc[6] = {1, 1, 1, 1, 1, 1};
+    double expect[6];
+    for (int i = 0; i < 6; i++) expect[i] = 1.0 - 0.5 * ref[i];
+    gemm(acc, a, b, 3, 4, 2, 0, 0, -0.5, 1.0);
+    check(close_all(acc, expect, 6), "c = c - 0.5 * a @ b");
+
+    for (int i = 0; i < 6; i++) { acc[i] = 2.0; expect[i] = 6.0 + 2.0 * ref[i]; }
+    gemm(acc, at, bt, 3, 4, 2, 1, 1, 2.0, 3.0);
+    check(close_all(acc, expect, 6), "c = 3c + 2 * a^T^T @ b^T^T");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
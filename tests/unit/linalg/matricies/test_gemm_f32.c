@@ -0,0 +1,79 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../../include/linalg/matricies/gemm_f32.h"
+#include "../../../../include/linalg/matricies/gemm.h"
+
+#define EPSILON 1e-5
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int close_all(float *x, double *y, int n) {
+    for (int i = 0; i < n; i++)
+        if (fabs(x[i] - y[i]) > EPSILON * (1.0 + fabs(y[i]))) return 0;
+    return 1;
+}
+
+int main() {
+    printf("=== Testing gemm_f32 ===\n\n");
+
+    // a is 3x4 (and its transpose 4x3), b is 4x2 (and its transpose 2x4)
+    double a[12], b[8], at[12], bt[8];
+    float af[12], bf[8], atf[12], btf[8];
+    for (int i = 0; i < 3; i++)
+        for (int k = 0; k < 4; k++) {
+            a[i * 4 + k] = at[k * 3 + i] = 0.5 * (i * 4 + k) - 2.0;
+        }
+    for (int k = 0; k < 4; k++)
+        for (int j = 0; j < 2; j++) {
+            b[k * 2 + j] = bt[j * 4 + k] = 1.0 - 0.25 * (k * 2 + j);
+        }
+    for (int i = 0; i < 12; i++) { af[i] = (float)a[i]; atf[i] = (float)at[i]; }
+    for (int i = 0; i < 8; i++) { bf[i] = (float)b[i]; btf[i] = (float)bt[i]; }
+
+    double ref[6];
+    gemm(ref, a, b, 3, 4, 2, 0, 0, 1.0, 0.0);
+
+    // Test 1: all four transpose combinations match the double gemm
+    float c[6];
+    gemm_f32(c, af, bf, 3, 4, 2, 0, 0, 1.0f, 0.0f);
+    check(close_all(c, ref, 6), "gemm_f32 NN matches gemm");
+
+    gemm_f32(c, atf, bf, 3, 4, 2, 1, 0, 1.0f, 0.0f);
+    check(close_all(c, ref, 6), "gemm_f32 TN matches gemm");
+
+    gemm_f32(c, af, btf, 3, 4, 2, 0, 1, 1.0f, 0.0f);
+    check(close_all(c, ref, 6), "gemm_f32 NT matches gemm");
+
+    gemm_f32(c, atf, btf, 3, 4, 2, 1, 1, 1.0f, 0.0f);
+    check(close_all(c, ref, 6), "gemm_f32 TT matches gemm");
+
+    // Test 2: beta = 0 ignores garbage in c
+    float nan_c[6];
+    for (int i = 0; i < 6; i++) nan_c[i] = NAN;
+    gemm_f32(nan_c, af, bf, 3, 4, 2, 0, 0, 1.0f, 0.0f);
+    check(close_all(nan_c, ref, 6), "beta = 0 overwrites c");
+
+    // Test 3: alpha and beta blend with c
+    float acc[6];
+    double expect[6];
+    for (int i = 0; i < 6; i++) { acc[i] = 2.0f; expect[i] = 6.0 - 0.5 * ref[i]; }
+    gemm_f32(acc, af, bf, 3, 4, 2, 0, 0, -0.5f, 3.0f);
+    check(close_all(acc, expect, 6), "c = 3c - 0.5 * a @ b");
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/optimizers/adam.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+
+int main() {
+    printf("=== Testing adam ===\n\n");
+
+    // Test 1: matches the textbook Adam update over several steps
+    double w[3] = {1.0, -2.0, 0.5};
+    double ref[3] = {1.0, -2.0, 0.5};
+    double rm[3] = {0}, rv[3] = {0};
+    double b1 = 0.9, b2 = 0.999, eps = 1e-8, lr = 0.01, wd = 0.1;
+
+    AdamState *adam = adam_create(3, b1, b2, eps, wd);
+    check(adam != NULL, "adam_create returns state");
+
+    int same = 1;
+    for (int t = 1; t <= 5; t++) {
+        double g[3] = {0.3 * t, -0.1, 2.0 / t};
+        for (int i = 0; i < 3; i++) {
+            double gi = g[i] + wd * ref[i];
+            rm[i] = b1 * rm[i] + (1 - b1) * gi;
+            rv[i] = b2 * rv[i] + (1 - b2) * gi * gi;
+            double mh = rm[i] / (1 - pow(b1, t));
+            double vh = rv[i] / (1 - pow(b2, t));
+            ref[i] -= lr * mh / (sqrt(vh) + eps);
+        }
+        adam_update(adam, w, g, lr);
+        for (int i = 0; i < 3; i++)
+            if (fabs(w[i] - ref[i]) > EPSILON) same = 0;
+    }
+    check(same, "Adam (L2 weight decay) matches reference");
+    check(adam->t == 5, "step counter advances");
+    adam_destroy(adam);
+
+    // Test 2: AdamW decouples weight decay from the moments
+    double ww[2] = {2.0, -1.0};
+    double wref[2] = {2.0, -1.0};
+    double wm[2] = {0}, wv[2] = {0};
+    AdamState *adamw = adamw_create(2, b1, b2, eps, wd);
+    same = 1;
+    for (int t = 1; t <= 4; t++) {
+        double g[2] = {0.5, -0.25 * t};
+        for (int i = 0; i < 2; i++) {
+            wref[i] *= 1 - lr * wd;
+            wm[i] = b1 * wm[i] + (1 - b1) * g[i];
+            wv[i] = b2 * wv[i] + (1 - b2) * g[i] * g[i];
+            double mh = wm[i] / (1 - pow(b1, t));
+            double vh = wv[i] / (1 - pow(b2, t));
+            wref[i] -= lr * mh / (sqrt(vh) + eps);
+        }
+        adam_update(adamw, ww, g, lr);
+        for (int i = 0; i < 2; i++)
+            if (fabs(ww[i] - wref[i]) > EPSILON) same = 0;
+    }
+    check(same, "AdamW (decoupled weight decay) matches reference");
+    adam_destroy(adamw);
+
+    // Test 3: minimizes sum (w - 3)^2
+    double q[4] = {0.0, 10.0, -5.0, 3.0};
+    adam = adam_create(4, b1, b2, eps, 0.0);
+    for (int s = 0; s < 2000; s++) {
+        double g[4];
+        for (int i = 0; i < 4; i++) g[i] = 2.0 * (q[i] - 3.0);
+        adam_update(adam, q, g, 0.05);
+    }
+    int conv = 1;
+    for (int i = 0; i < 4; i++)
+        if (fabs(q[i] - 3.0) > 1e-3) conv = 0;
+    check(conv, "Adam converges on a quadratic");
+    adam_destroy(adam);
+
+    // Test 4: sparse rows get the dense update, other rows are untouched
+    double table[8] = {1.0, -2.0, 0.5, 0.25, -1.5, 3.0, 0.75, -0.5};
+    double packed[4] = {1.0, -2.0, -1.5, 3.0};
+    int rows[2] = {0, 2};
+    adam = adam_create(8, b1, b2, eps, wd);
+    AdamState *dense = adam_create(4, b1, b2, eps, wd);
+    same = 1;
+    for (int t = 1; t <= 4; t++) {
+        double g[4] = {0.5 * t, -0.2, 1.0 / t, 0.3};
+        SparseGrad sg = {rows, g, 2, 2};
+        adam_update_sparse(adam, table, &sg, lr);
+        adam_update(dense, packed, g, lr);
+        for (int j = 0; j < 2; j++)
+            if (fabs(table[j] - packed[j]) > EPSILON || fabs(table[4 + j] - packed[2 + j]) > EPSILON) same = 0;
+    }
+    check(same, "sparse rows match the dense update");
+    check(table[2] == 0.5 && table[3] == 0.25 && table[6] == 0.75 && table[7] == -0.5,
+          "untouched rows keep their weights");
+    check(adam->t == 4, "sparse steps advance the step counter");
+    adam_destroy(adam);
+    adam_destroy(dense);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/optimizers/momentum.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+
+int main() {
+    printf("=== Testing momentum ===\n\n");
+
+    double mu = 0.9, wd = 0.01, lr = 0.1;
+
+    // Test 1: heavy-ball momentum matches reference
+    double w[2] = {1.0, -1.0};
+    double ref[2] = {1.0, -1.0};
+    double rv[2] = {0};
+    MomentumState *state = momentum_create(2, mu, wd, 0);
+    check(state != NULL, "momentum_create returns state");
+
+    int same = 1;
+    for (int t = 1; t <= 5; t++) {
+        double g[2] = {0.5 * t, -0.2};
+        for (int i = 0; i < 2; i++) {
+            double gi = g[i] + wd * ref[i];
+            rv[i] = mu * rv[i] + gi;
+            ref[i] -= lr * rv[i];
+        }
+        momentum_update(state, w, g, lr);
+        for (int i = 0; i < 2; i++)
+            if (fabs(w[i] - ref[i]) > EPSILON) same = 0;
+    }
+    check(same, "momentum matches reference");
+    momentum_destroy(state);
+
+    // Test 2: Nesterov look-ahead matches reference
+    double wn[2] = {1.0, -1.0};
+    double nref[2] = {1.0, -1.0};
+    double nv[2] = {0};
+    state = momentum_create(2, mu, wd, 1);
+    same = 1;
+    for (int t = 1; t <= 5; t++) {
+        double g[2] = {0.5 * t, -0.2};
+        for (int i = 0; i < 2; i++) {
+            double gi = g[i] + wd * nref[i];
+            nv[i] = mu * nv[i] + gi;
+            nref[i] -= lr * (gi + mu * nv[i]);
+        }
+        momentum_update(state, wn, g, lr);
+        for (int i = 0; i < 2; i++)
+            if (fabs(wn[i] - nref[i]) > EPSILON) same = 0;
+    }
+    check(same, "Nesterov momentum matches reference");
+    momentum_destroy(state);
+
+    // Test 3: zero momentum reduces to plain SGD
+    double s[1] = {2.0};
+    double g[1] = {0.5};
+    state = momentum_create(1, 0.0, 0.0, 0);
+    momentum_update(state, s, g, 0.1);
+    check(fabs(s[0] - 1.95) < EPSILON, "momentum = 0 is plain SGD");
+    momentum_destroy(state);
+
+    // Test 4: converges on a quadratic
+    double q[3] = {10.0, -4.0, 0.0};
+    state = momentum_create(3, mu, 0.0, 1);
+    for (int it = 0; it < 500; it++) {
+        double gq[3];
+        for (int i = 0; i < 3; i++) gq[i] = 2.0 * (q[i] - 1.0);
+        momentum_update(state, q, gq, 0.05);
+    }
+    check(fabs(q[0] - 1.0) < 1e-6 && fabs(q[1] - 1.0) < 1e-6 && fabs(q[2] - 1.0) < 1e-6,
+          "Nesterov momentum converges on a quadratic");
+    momentum_destroy(state);
+
+    // Test 5: sparse rows get the dense update, other rows are untouched
+    double table[8] = {1.0, -2.0, 0.5, 0.25, -1.5, 3.0, 0.75, -0.5};
+    double packed[4] = {1.0, -2.0, -1.5, 3.0};
+    int rows[2] = {0, 2};
+    state = momentum_create(8, mu, wd, 1);
+    MomentumState *dense = momentum_create(4, mu, wd, 1);
+    same = 1;
+    for (int t = 1; t <= 4; t++) {
+        double g[4] = {0.5 * t, -0.2, 1.0 / t, 0.3};
+        SparseGrad sg = {rows, g, 2, 2};
+        momentum_update_sparse(state, table, &sg, lr);
+        momentum_update(dense, packed, g, lr);
+        for (int j = 0; j < 2; j++)
+            if (fabs(table[j] - packed[j]) > EPSILON || fabs(table[4 + j] - packed[2 + j]) > EPSILON) same = 0;
+    }
+    check(same, "sparse rows match the dense update");
+    check(table[2] == 0.5 && table[3] == 0.25 && table[6] == 0.75 && table[7] == -0.5,
+          "untouched rows keep their weights");
+    momentum_destroy(state);
+    momentum_destroy(dense);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/optimizers/rmsprop.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+
+int main() {
+    printf("=== Testing rmsprop ===\n\n");
+
+    double rho = 0.99, eps = 1e-8, wd = 0.05, lr = 0.01;
+
+    // Test 1: matches reference
+    double w[3] = {1.0, 0.0, -3.0};
+    double ref[3] = {1.0, 0.0, -3.0};
+    double rs[3] = {0};
+    RMSPropState *state = rmsprop_create(3, rho, eps, wd);
+    check(state != NULL, "rmsprop_create returns state");
+
+    int same = 1;
+    for (int t = 1; t <= 6; t++) {
+        double g[3] = {1.0 / t, -0.5, 0.1 * t};
+        for (int i = 0; i < 3; i++) {
+            double gi = g[i] + wd * ref[i];
+            rs[i] = rho * rs[i] + (1 - rho) * gi * gi;
+            ref[i] -= lr * gi / (sqrt(rs[i]) + eps);
+        }
+        rmsprop_update(state, w, g, lr);
+        for (int i = 0; i < 3; i++)
+            if (fabs(w[i] - ref[i]) > EPSILON) same = 0;
+    }
+    check(same, "RMSProp matches reference");
+    rmsprop_destroy(state);
+
+    // Test 2: zero gradient and no decay leaves weights unchanged
+    double z[2] = {4.0, -4.0};
+    double g0[2] = {0.0, 0.0};
+    state = rmsprop_create(2, rho, eps, 0.0);
+    rmsprop_update(state, z, g0, lr);
+    check(z[0] == 4.0 && z[1] == -4.0, "zero gradient is a no-op");
+    rmsprop_destroy(state);
+
+    // Test 3: converges on a quadratic
+    double q[2] = {5.0, -5.0};
+    state = rmsprop_create(2, 0.9, eps, 0.0);
+    for (int it = 0; it < 3000; it++) {
+        double gq[2] = {2.0 * q[0], 2.0 * q[1]};
+        rmsprop_update(state, q, gq, 0.01 * (it < 2000 ? 1.0 : 0.1));
+    }
+    check(fabs(q[0]) < 1e-2 && fabs(q[1]) < 1e-2, "RMSProp converges on a quadratic");
+    rmsprop_destroy(state);
+
+    // Test 4: sparse rows get the dense update, other rows are untouched
+    double table[8] = {1.0, -2.0, 0.5, 0.25, -1.5, 3.0, 0.75, -0.5};
+    double packed[4] = {1.0, -2.0, -1.5, 3.0};
+    int rows[2] = {0, 2};
+    state = rmsprop_create(8, rho, eps, wd);
+    RMSPropState *dense = rmsprop_create(4, rho, eps, wd);
+    same = 1;
+    for (int t = 1; t <= 4; t++) {
+        double g[4] = {0.5 * t, -0.2, 1.0 / t, 0.3};
+        SparseGrad sg = {rows, g, 2, 2};
+        rmsprop_update_sparse(state, table, &sg, lr);
+        rmsprop_update(dense, packed, g, lr);
+        for (int j = 0; j < 2; j++)
+            if (fabs(table[j] - packed[j]) > EPSILON || fabs(table[4 + j] - packed[2 + j]) > EPSILON) same = 0;
+    }
+    check(same, "sparse rows match the dense update");
+    check(table[2] == 0.5 && table[3] == 0.25 && table[6] == 0.75 && table[7] == -0.5,
+          "untouched rows keep their weights");
+    rmsprop_destroy(state);
+    rmsprop_destroy(dense);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -75,6 +75,22 @@ int main() {
     // 1.0 - 0.5 * (-2.0) = 1.0 + 1.0 = 2.0
     check(fabs(result[0] - 2.0) < EPSILON, "Negative gradient: weight increases");
 
+    arena_clear(arena);
+
+    // Test 6: Sparse update touches only the listed rows, in place
+    double table[6] = {1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    double dense_g[6] = {0.0, 0.0, 0.0, 0.0, 1.0, -2.0};
+    double sparse_g[2] = {1.0, -2.0};
+    int rows[1] = {2};
+    SparseGrad sg = {rows, sparse_g, 1, 2};
+    result = sgd_update(arena, table, dense_g, 0.5, 6);
+    sgd_update_sparse(table, &sg, 0.5);
+    int same = 1;
+    for (int i = 0; i < 6; i++)
+        if (fabs(table[i] - result[i]) > EPSILON) same = 0;
+    check(same, "Sparse update matches the dense update");
+    check(table[0] == 1.0 && table[3] == 4.0, "Sparse update leaves other rows alone");
+
     arena_destroy(arena);
 
     printf("\n=== Results ===\n");
@@ -0,0 +1,124 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/attention.h"
+#include "../../../include/arena.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+// sizes straddle ATTENTION_TILE so partial tiles are exercised
+#define SQ 70
+#define SK 131
+#define D 8
+#define DV 5
+
+double q[SQ * D], k[SK * D], v[SK * DV], probe[SQ * DV];
+
+// materializes the whole score matrix: the textbook definition
+void reference(double *out, double *lse, double *qq, int sq) {
+    static double s[SK];
+    for (int i = 0; i < sq; i++) {
+        double max = -INFINITY, sum = 0.0;
+        for (int j = 0; j < SK; j++) {
+            s[j] = 0.0;
+            for (int c = 0; c < D; c++) s[j] += qq[i * D + c] * k[j * D + c];
+            s[j] /= sqrt(D);
+            if (s[j] > max) max = s[j];
+        }
+        for (int j = 0; j < SK; j++) sum += (s[j] = exp(s[j] - max));
+        for (int c = 0; c < DV; c++) {
+            out[i * DV + c] = 0.0;
+            for (int j = 0; j < SK; j++) out[i * DV + c] += s[j] / sum * v[j * DV + c];
+        }
+        lse[i] = max + log(sum);
+    }
+}
+
+double loss(Arena *arena) {
+    ArenaTemp temp = arena_temp_begin(arena);
+    double *out = attention_forward(arena, q, k, v, SQ, SK, D, DV, NULL);
+    double sum = 0.0;
+    for (int i = 0; i < SQ * DV; i++) sum += probe[i] * out[i];
+    arena_temp_end(temp);
+    return sum;
+}
+
+double max_err(double *analytic, double *value, int n, Arena *arena) {
+    double worst = 0.0;
+    for (int i = 0; i < n; i++) {
+        double keep = value[i], eps = 1e-6;
+        value[i] = keep + eps;
+        double up = loss(arena);
+        value[i] = keep - eps;
+        double down = loss(arena);
+        value[i] = keep;
+        double err = fabs((up - down) / (2 * eps) - analytic[i]);
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+int main() {
+    printf("=== Testing attention ===\n\n");
+
+    Arena *arena = arena_create(1 << 20);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    for (int i = 0; i < SQ * D; i++) q[i] = 1.5 * sin(0.91 * i);
+    for (int i = 0; i < SK * D; i++) k[i] = 1.5 * cos(0.37 * i + 0.2);
+    for (int i = 0; i < SK * DV; i++) v[i] = sin(0.53 * i) - 0.2;
+    for (int i = 0; i < SQ * DV; i++) probe[i] = cos(1.7 * i);
+
+    // Test 1: tiled forward matches the materialized softmax
+    static double ref[SQ * DV], ref_lse[SQ];
+    reference(ref, ref_lse, q, SQ);
+
+    double *lse;
+    double *out = attention_forward(arena, q, k, v, SQ, SK, D, DV, &lse);
+    check(out != NULL && lse != NULL, "attention_forward returns output and lse");
+
+    double worst = 0.0;
+    for (int i = 0; i < SQ * DV; i++) worst = fmax(worst, fabs(out[i] - ref[i]));
+    check(worst < 1e-12, "output matches softmax(q k^T / sqrt(d)) v");
+
+    worst = 0.0;
+    for (int i = 0; i < SQ; i++) worst = fmax(worst, fabs(lse[i] - ref_lse[i]));
+    check(worst < 1e-12, "lse matches log-sum-exp of the scores");
+
+    // Test 2: gradients match central differences
+    AttentionGrad g = attention_backward(arena, probe, q, k, v, out, lse, SQ, SK, D, DV);
+    check(g.d_q && g.d_k && g.d_v, "attention_backward returns gradients");
+    check(max_err(g.d_q, q, SQ * D, arena) < 1e-7, "d_q matches finite differences");
+    check(max_err(g.d_k, k, SK * D, arena) < 1e-7, "d_k matches finite differences");
+    check(max_err(g.d_v, v, SK * DV, arena) < 1e-7, "d_v matches finite differences");
+
+    // Test 3: huge scores stay finite thanks to the running max
+    static double big[SQ * D];
+    for (int i = 0; i < SQ * D; i++) big[i] = 400.0 * q[i];
+    out = attention_forward(arena, big, k, v, SQ, SK, D, DV, NULL);
+    int finite = 1;
+    for (int i = 0; i < SQ * DV; i++)
+        if (!isfinite(out[i])) finite = 0;
+    check(finite, "large scores do not overflow");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/batch_norm.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-6
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+// weighted sum of the training-mode output, so every output gets a distinct gradient
+double objective(Arena *arena, BatchNormLayer *bn, double *x, double *w, int m) {
+    double rm[3], rv[3];
+    for (int j = 0; j < 3; j++) { rm[j] = bn->running_mean[j]; rv[j] = bn->running_var[j]; }
+
+    u64 mark = arena_pos(arena);
+    double *y = batch_norm_forward(arena, bn, x, m, 1, NULL);
+    double s = 0.0;
+    for (int i = 0; i < m * 3; i++) s += w[i] * y[i];
+    arena_pop_to(arena, mark);
+
+    for (int j = 0; j < 3; j++) { bn->running_mean[j] = rm[j]; bn->running_var[j] = rv[j]; }
+    return s;
+}
+
+int main() {
+    printf("=== Testing batch_norm ===\n\n");
+
+    Arena *arena = arena_create(1 << 16);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    double params[4 * 3];
+    BatchNormLayer bn;
+    batch_norm_init(&bn, params, 3);
+    check(bn.gamma[0] == 1.0 && bn.beta[0] == 0.0 && bn.running_var[2] == 1.0, "init sets identity affine and unit running variance");
+
+    // Test 1: training mode normalizes each column to zero mean and unit variance
+    int m = 6;
+    double x[6 * 3];
+    for (int i = 0; i < m * 3; i++) x[i] = 3.0 * sin(0.9 * i) + (i % 3) * 5.0;
+
+    BatchNormCache cache;
+    double *y = batch_norm_forward(arena, &bn, x, m, 1, &cache);
+    check(y != NULL && cache.x_hat != NULL, "forward returns output and cache");
+
+    int ok = 1;
+    for (int j = 0; j < 3; j++) {
+        double s = 0.0, v = 0.0;
+        for (int i = 0; i < m; i++) s += y[i * 3 + j];
+        for (int i = 0; i < m; i++) v += y[i * 3 + j] * y[i * 3 + j];
+        if (fabs(s / m) > EPSILON || fabs(v / m - 1.0) > 1e-4) ok = 0;
+    }
+    check(ok, "training output has zero mean and unit variance per column");
+
+    // Test 2: running statistics move by momentum towards the batch statistics
+    double mean0 = 0.0, var0 = 0.0;
+    for (int i = 0; i < m; i++) mean0 += x[i * 3];
+    mean0 /= m;
+    for (int i = 0; i < m; i++) var0 += (x[i * 3] - mean0) * (x[i * 3] - mean0);
+    var0 /= m - 1;
+    check(fabs(bn.running_mean[0] - 0.1 * mean0) < EPSILON, "running mean updated with momentum");
+    check(fabs(bn.running_var[0] - (0.9 + 0.1 * var0)) < EPSILON, "running variance uses the unbiased estimate");
+
+    // Test 3: inference mode uses the running statistics and leaves them alone
+    bn.gamma[1] = 2.0;
+    bn.beta[1] = -1.0;
+    double rm1 = bn.running_mean[1];
+    double *yi = batch_norm_forward(arena, &bn, x, m, 0, NULL);
+    double expect = 2.0 * (x[4] - rm1) / sqrt(bn.running_var[1] + bn.eps) - 1.0;
+    check(fabs(yi[4] - expect) < EPSILON, "inference applies running statistics and affine");
+    check(bn.running_mean[1] == rm1, "inference does not update running statistics");
+
+    // Test 4: backward matches finite differences for input, gamma and beta
+    double w[6 * 3];
+    for (int i = 0; i < m * 3; i++) w[i] = cos(1.7 * i);
+    bn.gamma[0] = 0.5; bn.beta[2] = 0.3;
+
+    y = batch_norm_forward(arena, &bn, x, m, 1, &cache);
+    double d_gamma[3], d_beta[3];
+    double *dx = batch_norm_backward(arena, &bn, w, &cache, m, d_gamma, d_beta);
+
+    double h = 1e-6, max_err = 0.0;
+    for (int i = 0; i < m * 3; i++) {
+        double keep = x[i];
+        x[i] = keep + h; double up = objective(arena, &bn, x, w, m);
+        x[i] = keep - h; double down = objective(arena, &bn, x, w, m);
+        x[i] = keep;
+        max_err = fmax(max_err, fabs(dx[i] - (up - down) / (2 * h)));
+    }
+    check(max_err < EPSILON, "d_input matches finite differences");
+
+    max_err = 0.0;
+    for (int j = 0; j < 3; j++) {
+        double keep = bn.gamma[j];
+        bn.gamma[j] = keep + h; double up = objective(arena, &bn, x, w, m);
+        bn.gamma[j] = keep - h; double down = objective(arena, &bn, x, w, m);
+        bn.gamma[j] = keep;
+        max_err = fmax(max_err, fabs(d_gamma[j] - (up - down) / (2 * h)));
+
+        keep = bn.beta[j];
+        bn.beta[j] = keep + h; up = objective(arena, &bn, x, w, m);
+        bn.beta[j] = keep - h; down = objective(arena, &bn, x, w, m);
+        bn.beta[j] = keep;
+        max_err = fmax(max_err, fabs(d_beta[j] - (up - down) / (2 * h)));
+    }
+    check(max_err < EPSILON, "d_gamma and d_beta match finite differences");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
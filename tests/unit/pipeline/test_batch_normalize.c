@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <math.h>
+#include <stdlib.h>
 #include "../../../include/pipeline/batch_normalize.h"
 #include "../../../include/arena.h"
 
@@ -68,6 +69,29 @@ int main() {
 
     arena_destroy(arena);
 
+    // Test 5: a tall matrix that a per-column stack copy could not hold
+    int tall = 1 << 21;
+    double *big = malloc((size_t)tall * 2 * sizeof(double));
+    for (int i = 0; i < tall; i++) {
+        big[2 * i] = i % 97;
+        big[2 * i + 1] = 1e6 + (i % 5);
+    }
+    arena = arena_create((u64)tall * 2 * sizeof(double) + 4096);
+    u64 before = arena_pos(arena);
+    result = batch_normalize(arena, big, tall, 2);
+    check(result != NULL, "Tall matrix normalizes");
+    check(arena_pos(arena) - before <= (u64)tall * 2 * sizeof(double) + ALIGNMENT,
+          "Only the output is left on the arena");
+    double s0 = 0.0, s1 = 0.0;
+    for (int i = 0; i < tall; i++) {
+        s0 += result[2 * i];
+        s1 += result[2 * i + 1] * result[2 * i + 1];
+    }
+    check(fabs(s0 / tall) < EPSILON && fabs(s1 / tall - 1.0) < EPSILON,
+          "Tall matrix columns have mean ~0 and std ~1");
+    arena_destroy(arena);
+    free(big);
+
     printf("\n=== Results ===\n");
     printf("Passed: %d\n", test_passed);
     printf("Failed: %d\n", test_failed);
@@ -0,0 +1,111 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/conv2d.h"
+#include "../../../include/pipeline/im2col.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-9
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+// 2 samples, 2 channels, 5x6 images, 3 filters of 3x3, stride 2, padding 1
+#define M 2
+#define C 2
+#define H 5
+#define W 6
+#define F 3
+#define K 3
+
+double input[M * C * H * W], weights[F * C * K * K], bias[F], dout[M * F * 3 * 3];
+Window2d shape = {C, H, W, K, 2, 1};
+
+double direct(int s, int f, int y, int x) {
+    double sum = bias[f];
+    for (int c = 0; c < C; c++)
+        for (int ki = 0; ki < K; ki++)
+            for (int kj = 0; kj < K; kj++) {
+                int iy = y * 2 - 1 + ki, ix = x * 2 - 1 + kj;
+                if (iy < 0 || iy >= H || ix < 0 || ix >= W) continue;
+                sum += weights[((f * C + c) * K + ki) * K + kj] * input[((s * C + c) * H + iy) * W + ix];
+            }
+    return sum;
+}
+
+double objective(Arena *arena) {
+    u64 mark = arena_pos(arena);
+    double *out = conv2d_forward(arena, input, weights, bias, M, &shape, F);
+    double s = 0.0;
+    for (int i = 0; i < M * F * 9; i++) s += out[i] * dout[i];
+    arena_pop_to(arena, mark);
+    return s;
+}
+
+double fd_error(Arena *arena, double *param, int n, double *grad) {
+    double h = 1e-6, max_err = 0.0;
+    for (int i = 0; i < n; i++) {
+        double keep = param[i];
+        param[i] = keep + h; double up = objective(arena);
+        param[i] = keep - h; double down = objective(arena);
+        param[i] = keep;
+        max_err = fmax(max_err, fabs(grad[i] - (up - down) / (2 * h)));
+    }
+    return max_err;
+}
+
+int main() {
+    printf("=== Testing conv2d ===\n\n");
+
+    Arena *arena = arena_create(1 << 16);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    for (int i = 0; i < M * C * H * W; i++) input[i] = sin(0.41 * i);
+    for (int i = 0; i < F * C * K * K; i++) weights[i] = cos(0.53 * i) * 0.5;
+    for (int i = 0; i < F; i++) bias[i] = 0.1 * i - 0.1;
+    for (int i = 0; i < M * F * 9; i++) dout[i] = sin(1.1 * i + 0.2);
+
+    // Test 1: forward matches a direct convolution
+    check(window_out(H, K, 2, 1) == 3 && window_out(W, K, 2, 1) == 3, "5x6 with stride 2, pad 1 gives 3x3");
+    double *out = conv2d_forward(arena, input, weights, bias, M, &shape, F);
+    check(out != NULL, "conv2d_forward returns output");
+
+    double max_err = 0.0;
+    for (int s = 0; s < M; s++)
+        for (int f = 0; f < F; f++)
+            for (int y = 0; y < 3; y++)
+                for (int x = 0; x < 3; x++)
+                    max_err = fmax(max_err, fabs(out[((s * F + f) * 3 + y) * 3 + x] - direct(s, f, y, x)));
+    check(max_err < EPSILON, "forward matches direct convolution");
+
+    // Test 2: no bias
+    double *nb = conv2d_forward(arena, input, weights, NULL, M, &shape, F);
+    check(fabs(nb[0] - (out[0] - bias[0])) < EPSILON, "NULL bias skips the bias add");
+
+    // Test 3: backward matches finite differences
+    ConvGrad g = conv2d_backward(arena, dout, input, weights, M, &shape, F);
+    check(g.d_weights && g.d_bias && g.d_input, "conv2d_backward returns gradients");
+    check(fd_error(arena, weights, F * C * K * K, g.d_weights) < 1e-6, "d_weights matches finite differences");
+    check(fd_error(arena, bias, F, g.d_bias) < 1e-6, "d_bias matches finite differences");
+    check(fd_error(arena, input, M * C * H * W, g.d_input) < 1e-6, "d_input matches finite differences");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,83 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/dense_forward.h"
+#include "../../../include/pipeline/dense_backward.h"
+#include "../../../include/pipeline/dense_backward_accumulate.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-10
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing dense_backward_accumulate ===\n\n");
+
+    Arena *arena = arena_create(65536);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    // Test 1: accumulates into an existing gradient
+    double input1[] = {1.0, 2.0, 3.0, 4.0};
+    double weights1[] = {0.5, 0.5};
+    double dout1[] = {1.0, 1.0};
+    double dw1[] = {10.0, 20.0};
+
+    double *d_input = dense_backward_accumulate(arena, dout1, input1, weights1, NULL, dw1, 2, 2, 1, ACTIVATION_NONE);
+    check(d_input != NULL, "ACTIVATION_NONE: d_input non-null");
+
+    // input^T @ dout = [4, 6]
+    check(fabs(dw1[0] - 14.0) < EPSILON && fabs(dw1[1] - 26.0) < EPSILON,
+          "ACTIVATION_NONE: d_weights += input^T @ dout");
+    check(fabs(d_input[0] - 0.5) < EPSILON && fabs(d_input[3] - 0.5) < EPSILON,
+          "ACTIVATION_NONE: d_input correct");
+    check(weights1[0] == 0.5 && weights1[1] == 0.5, "weights are not modified");
+
+    arena_clear(arena);
+
+    // Test 2: two micro-batches sum to the full-batch gradient
+    int m = 6, n = 3, p = 2;
+    double input[6 * 3], w[3 * 2], dout[6 * 2];
+    for (int i = 0; i < m * n; i++) input[i] = ((i * 5) % 7 - 3) / 4.0;
+    for (int i = 0; i < n * p; i++) w[i] = ((i * 3) % 5 - 2) / 3.0;
+    for (int i = 0; i < m * p; i++) dout[i] = ((i * 7) % 4 - 1.5) / 2.0;
+
+    double *cache;
+    dense_forward(arena, input, w, m, n, p, ACTIVATION_RELU, &cache);
+    LayerGrad full = dense_backward(arena, dout, input, w, cache, m, n, p, ACTIVATION_RELU);
+
+    double dw[3 * 2] = {0};
+    dense_backward_accumulate(arena, dout, input, w, cache, dw, 4, n, p, ACTIVATION_RELU);
+    double *d_tail = dense_backward_accumulate(arena, dout + 4 * p, input + 4 * n, w, cache + 4 * p, dw,
+                                               2, n, p, ACTIVATION_RELU);
+
+    int same = 1;
+    for (int i = 0; i < n * p; i++)
+        if (fabs(dw[i] - full.d_weights[i]) > EPSILON) same = 0;
+    check(same, "ACTIVATION_RELU: micro-batches sum to the full-batch d_weights");
+
+    same = 1;
+    for (int i = 0; i < 2 * n; i++)
+        if (fabs(d_tail[i] - full.d_input[4 * n + i]) > EPSILON) same = 0;
+    check(same, "ACTIVATION_RELU: micro-batch d_input matches its rows of the full batch");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,101 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/dense_forward.h"
+#include "../../../include/pipeline/dense_backward.h"
+#include "../../../include/pipeline/dense_backward_sgd.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-10
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing dense_backward_sgd ===\n\n");
+
+    Arena *arena = arena_create(1 << 20);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    // Test 1: ACTIVATION_NONE on a small layer
+    double input1[] = {1.0, 2.0, 3.0, 4.0};
+    double weights1[] = {0.5, 0.5};
+    double dout1[] = {1.0, 1.0};
+
+    double *d_input = dense_backward_sgd(arena, dout1, input1, weights1, NULL, 2, 2, 1, ACTIVATION_NONE, 0.1);
+    check(d_input != NULL, "ACTIVATION_NONE: d_input non-null");
+
+    // d_input uses the weights from before the update
+    check(fabs(d_input[0] - 0.5) < EPSILON && fabs(d_input[3] - 0.5) < EPSILON,
+          "ACTIVATION_NONE: d_input uses pre-update weights");
+
+    // d_weights = [4, 6], so W = [0.5 - 0.4, 0.5 - 0.6]
+    check(fabs(weights1[0] - 0.1) < EPSILON && fabs(weights1[1] + 0.1) < EPSILON,
+          "ACTIVATION_NONE: weights updated in place");
+
+    arena_clear(arena);
+
+    // Test 2: matches dense_backward + SGD across several tiles
+    int m = 7, n = 3 * DENSE_SGD_TILE + 5, p = 4;
+    double input[7 * (3 * DENSE_SGD_TILE + 5)];
+    double w_ref[(3 * DENSE_SGD_TILE + 5) * 4];
+    double w[(3 * DENSE_SGD_TILE + 5) * 4];
+    double dout[7 * 4];
+
+    for (int i = 0; i < m * n; i++) input[i] = ((i * 37) % 11 - 5) / 7.0;
+    for (int i = 0; i < n * p; i++) w[i] = w_ref[i] = ((i * 13) % 9 - 4) / 10.0;
+    for (int i = 0; i < m * p; i++) dout[i] = ((i * 7) % 5 - 2) / 3.0;
+
+    double *cache;
+    dense_forward(arena, input, w, m, n, p, ACTIVATION_RELU, &cache);
+
+    LayerGrad grad = dense_backward(arena, dout, input, w_ref, cache, m, n, p, ACTIVATION_RELU);
+    for (int i = 0; i < n * p; i++) w_ref[i] -= 0.05 * grad.d_weights[i];
+
+    d_input = dense_backward_sgd(arena, dout, input, w, cache, m, n, p, ACTIVATION_RELU, 0.05);
+
+    int same_w = 1;
+    for (int i = 0; i < n * p; i++)
+        if (fabs(w[i] - w_ref[i]) > EPSILON) same_w = 0;
+    check(same_w, "ACTIVATION_RELU: weights match dense_backward + SGD");
+
+    int same_d = 1;
+    for (int i = 0; i < m * n; i++)
+        if (fabs(d_input[i] - grad.d_input[i]) > EPSILON) same_d = 0;
+    check(same_d, "ACTIVATION_RELU: d_input matches dense_backward");
+
+    arena_clear(arena);
+
+    // Test 3: ACTIVATION_SIGMOID
+    double input3[] = {2.0};
+    double weights3[] = {0.0};
+    double *cache3;
+    dense_forward(arena, input3, weights3, 1, 1, 1, ACTIVATION_SIGMOID, &cache3);
+
+    double dout3[] = {1.0};
+    d_input = dense_backward_sgd(arena, dout3, input3, weights3, cache3, 1, 1, 1, ACTIVATION_SIGMOID, 1.0);
+
+    // d_act = 0.25, d_weights = 2 * 0.25 = 0.5
+    check(fabs(weights3[0] + 0.5) < EPSILON, "ACTIVATION_SIGMOID: weights updated");
+    check(fabs(d_input[0]) < EPSILON, "ACTIVATION_SIGMOID: d_input with zero weights");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,92 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/dropout.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing dropout ===\n\n");
+
+    Arena *arena = arena_create(1 << 20);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    int n = 10000;
+    static double x[10000];
+    for (int i = 0; i < n; i++) x[i] = 1.0 + i % 7;
+
+    // Test 1: kept elements are scaled, dropped ones are zero, the mask agrees
+    u64 *mask;
+    double *y = dropout_forward(arena, x, n, 0.3, 1234, 0, &mask);
+    check(y != NULL && mask != NULL, "dropout_forward returns output and mask");
+
+    int kept = 0, consistent = 1;
+    for (int i = 0; i < n; i++) {
+        int bit = (mask[i / 64] >> (i % 64)) & 1;
+        kept += bit;
+        if (bit && fabs(y[i] - x[i] / 0.7) > EPSILON) consistent = 0;
+        if (!bit && y[i] != 0.0) consistent = 0;
+    }
+    check(consistent, "output is x / (1 - rate) where kept and 0 elsewhere");
+    check(kept > 6800 && kept < 7200, "about 1 - rate of the elements are kept");
+
+    // Test 2: the mask uses one bit per element, and bits past n are clear
+    int words = DROPOUT_MASK_WORDS(n);
+    check(words == 157, "10000 elements pack into 157 words");
+    check((mask[words - 1] >> (n % 64)) == 0, "bits past n are zero");
+
+    // Test 3: reproducible from seed and step
+    u64 again[157], next[157];
+    dropout_mask(again, n, 0.3, 1234, 0);
+    dropout_mask(next, n, 0.3, 1234, 1);
+    int same = 1, differs = 0;
+    for (int w = 0; w < words; w++) {
+        if (again[w] != mask[w]) same = 0;
+        if (next[w] != mask[w]) differs = 1;
+    }
+    check(same, "same seed and step rebuild the same mask");
+    check(differs, "the next step draws a new mask");
+
+    // Test 4: backward applies the same mask and scale
+    static double dout[10000];
+    for (int i = 0; i < n; i++) dout[i] = 0.5;
+    double *dx = dropout_backward(arena, dout, mask, n, 0.3);
+    int ok = 1;
+    for (int i = 0; i < n; i++) {
+        double expect = y[i] != 0.0 ? 0.5 / 0.7 : 0.0;
+        if (fabs(dx[i] - expect) > EPSILON) ok = 0;
+    }
+    check(ok, "backward routes gradient through kept elements only");
+
+    // Test 5: rate 0 is the identity, invalid rates are rejected
+    double *id = dropout_forward(arena, x, 100, 0.0, 1, 0, NULL);
+    ok = 1;
+    for (int i = 0; i < 100; i++) if (id[i] != x[i]) ok = 0;
+    check(ok, "rate 0 keeps everything unscaled");
+    check(dropout_forward(arena, x, 100, 1.0, 1, 0, NULL) == NULL, "rate 1 rejected");
+    check(dropout_forward(arena, x, 100, -0.1, 1, 0, NULL) == NULL, "negative rate rejected");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
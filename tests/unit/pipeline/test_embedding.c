@@ -0,0 +1,87 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/embedding.h"
+#include "../../../include/optimizers/sgd_update.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+#define VOCAB 1000
+#define DIM 4
+
+int main() {
+    printf("=== Testing embedding ===\n\n");
+
+    Arena *arena = arena_create(1 << 20);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    static double table[VOCAB * DIM];
+    for (int i = 0; i < VOCAB * DIM; i++) table[i] = sin(0.37 * i);
+
+    // Test 1: forward gathers the rows of the looked-up ids
+    int ids[6] = {7, 998, 7, 0, 42, 998};
+    double *out = embedding_forward(arena, table, ids, 6, DIM);
+    check(out != NULL, "embedding_forward returns output");
+
+    int same = 1;
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < DIM; j++)
+            if (out[i * DIM + j] != table[ids[i] * DIM + j]) same = 0;
+    check(same, "output rows are copies of the table rows");
+
+    // Test 2: backward lists each touched row once, sorted, with summed gradients
+    double dout[6 * DIM];
+    for (int i = 0; i < 6 * DIM; i++) dout[i] = 0.1 * i - 1.0;
+
+    SparseGrad g = embedding_backward(arena, dout, ids, 6, DIM);
+    check(g.n_rows == 4 && g.dim == DIM, "duplicate ids collapse to one row each");
+    check(g.rows[0] == 0 && g.rows[1] == 7 && g.rows[2] == 42 && g.rows[3] == 998,
+          "rows are listed in ascending order");
+
+    static double dense[VOCAB * DIM];
+    for (int i = 0; i < 6; i++)
+        for (int j = 0; j < DIM; j++)
+            dense[ids[i] * DIM + j] += dout[i * DIM + j];
+
+    same = 1;
+    for (int r = 0; r < g.n_rows; r++)
+        for (int j = 0; j < DIM; j++)
+            if (fabs(g.values[r * DIM + j] - dense[g.rows[r] * DIM + j]) > EPSILON) same = 0;
+    check(same, "row gradients equal the dense scatter-add");
+
+    // Test 3: a sparse SGD step equals a dense step over the whole table
+    double *expect = sgd_update(arena, table, dense, 0.1, VOCAB * DIM);
+    sgd_update_sparse(table, &g, 0.1);
+    same = 1;
+    for (int i = 0; i < VOCAB * DIM; i++)
+        if (fabs(table[i] - expect[i]) > EPSILON) same = 0;
+    check(same, "sparse SGD matches the dense update");
+
+    // Test 4: an empty batch yields no rows
+    g = embedding_backward(arena, dout, ids, 0, DIM);
+    check(g.n_rows == 0, "empty batch has no touched rows");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/im2col.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing im2col ===\n\n");
+
+    // Test 1: output sizes
+    check(window_out(28, 5, 1, 0) == 24, "valid 5x5 on 28 gives 24");
+    check(window_out(28, 3, 1, 1) == 28, "same padding keeps the size");
+    check(window_out(7, 3, 2, 1) == 4, "stride 2 with padding");
+
+    // Test 2: 1 channel 3x3 image, 2x2 kernel, stride 1 -> 4 x 4 columns
+    // image = 1 2 3 / 4 5 6 / 7 8 9
+    double image[] = {1, 2, 3, 4, 5, 6, 7, 8, 9};
+    Window2d w = {1, 3, 3, 2, 1, 0};
+    double cols[16];
+    im2col(cols, image, &w);
+    double expect[] = {1, 2, 4, 5,   // tap (0,0)
+                       2, 3, 5, 6,   // tap (0,1)
+                       4, 5, 7, 8,   // tap (1,0)
+                       5, 6, 8, 9};  // tap (1,1)
+    int ok = 1;
+    for (int i = 0; i < 16; i++) if (fabs(cols[i] - expect[i]) > EPSILON) ok = 0;
+    check(ok, "taps unfold into rows");
+
+    // Test 3: padding reads zeros
+    Window2d wp = {1, 3, 3, 3, 2, 1};
+    double cols_p[9 * 4];
+    im2col(cols_p, image, &wp);
+    check(cols_p[0] == 0.0 && cols_p[4 * 4] == 1.0 && cols_p[4 * 4 + 3] == 9.0, "padded taps are zero, centre tap hits pixels");
+
+    // Test 4: col2im adds each entry back where it came from (pixel counts)
+    double ones[16], counts[9] = {0};
+    for (int i = 0; i < 16; i++) ones[i] = 1.0;
+    col2im(counts, ones, &w);
+    check(counts[0] == 1.0 && counts[1] == 2.0 && counts[4] == 4.0 && counts[8] == 1.0, "col2im counts overlapping windows");
+
+    // Test 5: col2im is the adjoint of im2col: <im2col(x), c> == <x, col2im(c)>
+    double x[2 * 5 * 4], c[2 * 9 * 3 * 2], back[2 * 5 * 4] = {0};
+    Window2d w2 = {2, 5, 4, 3, 2, 1};
+    double ux[2 * 9 * 3 * 2];
+    for (int i = 0; i < 40; i++) x[i] = sin(0.3 * i);
+    for (int i = 0; i < 108; i++) c[i] = cos(0.7 * i);
+    im2col(ux, x, &w2);
+    col2im(back, c, &w2);
+    double lhs = 0.0, rhs = 0.0;
+    for (int i = 0; i < 108; i++) lhs += ux[i] * c[i];
+    for (int i = 0; i < 40; i++) rhs += x[i] * back[i];
+    check(fabs(lhs - rhs) < 1e-9, "col2im is the adjoint of im2col");
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
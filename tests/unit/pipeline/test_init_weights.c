@@ -74,6 +74,30 @@ int main() {
 
     free(w3);
 
+    // Test 6: Xavier and He schemes hit their target variance
+    static double big[256 * 128];
+    InitScheme schemes[] = {INIT_XAVIER_UNIFORM, INIT_XAVIER_NORMAL, INIT_HE_UNIFORM, INIT_HE_NORMAL};
+    const char *names[] = {"Xavier uniform", "Xavier normal", "He uniform", "He normal"};
+    double targets[] = {2.0 / 384, 2.0 / 384, 2.0 / 256, 2.0 / 256};
+    Rng rng;
+    rng_seed(&rng, RNG_XOSHIRO, 7);
+    for (int s = 0; s < 4; s++) {
+        char label[96];
+        init_fill(&rng, big, 256, 128, schemes[s]);
+        double var = 0.0, limit = 0.0;
+        for (int i = 0; i < 256 * 128; i++) {
+            var += big[i] * big[i] / (256 * 128);
+            limit = fmax(limit, fabs(big[i]));
+        }
+        snprintf(label, sizeof(label), "%s: variance matches the scheme", names[s]);
+        check(fabs(var / targets[s] - 1.0) < 0.03, label);
+
+        // uniform draws stay below sqrt(3 var), truncated ones below 2 std
+        double bound = s % 2 == 0 ? sqrt(3.0 * targets[s]) : 2.0 * sqrt(targets[s]) / 0.87962566103423978;
+        snprintf(label, sizeof(label), "%s: values respect the bound", names[s]);
+        check(limit <= bound, label);
+    }
+
     printf("\n=== Results ===\n");
     printf("Passed: %d\n", test_passed);
     printf("Failed: %d\n", test_failed);
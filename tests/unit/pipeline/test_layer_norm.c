@@ -0,0 +1,161 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/layer_norm.h"
+#include "../../../include/arena.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+#define N 64
+#define BIG_M 2048
+
+double x[BIG_M * N], dy[BIG_M * N], gamma_[N], beta_[N];
+
+// textbook two-pass normalization of one row
+void reference_row(double *y, double *xr, int rms) {
+    double mean = 0.0, var = 0.0;
+    if (!rms) {
+        for (int j = 0; j < N; j++) mean += xr[j];
+        mean /= N;
+    }
+    for (int j = 0; j < N; j++) var += (xr[j] - mean) * (xr[j] - mean);
+    double rstd = 1.0 / sqrt(var / N + LAYER_NORM_EPS);
+    for (int j = 0; j < N; j++) y[j] = (xr[j] - mean) * rstd * gamma_[j] + (rms ? 0.0 : beta_[j]);
+}
+
+double forward_err(Arena *arena, int m, int rms) {
+    double y[N], worst = 0.0;
+    double *out = rms ? rms_norm_forward(arena, x, gamma_, m, N, LAYER_NORM_EPS, NULL)
+                      : layer_norm_forward(arena, x, gamma_, beta_, m, N, LAYER_NORM_EPS, NULL);
+    if (!out) return 1e9;
+    for (int i = 0; i < m; i++) {
+        reference_row(y, x + i * N, rms);
+        for (int j = 0; j < N; j++) worst = fmax(worst, fabs(out[i * N + j] - y[j]));
+    }
+    return worst;
+}
+
+double loss(Arena *arena, int m, int rms) {
+    ArenaTemp temp = arena_temp_begin(arena);
+    double *out = rms ? rms_norm_forward(arena, x, gamma_, m, N, LAYER_NORM_EPS, NULL)
+                      : layer_norm_forward(arena, x, gamma_, beta_, m, N, LAYER_NORM_EPS, NULL);
+    double sum = 0.0;
+    for (int i = 0; i < m * N; i++) sum += dy[i] * out[i];
+    arena_temp_end(temp);
+    return sum;
+}
+
+double grad_err(Arena *arena, double *analytic, double *value, int count, int m, int rms) {
+    double worst = 0.0;
+    for (int i = 0; i < count; i++) {
+        double keep = value[i], eps = 1e-6;
+        value[i] = keep + eps;
+        double up = loss(arena, m, rms);
+        value[i] = keep - eps;
+        double down = loss(arena, m, rms);
+        value[i] = keep;
+        worst = fmax(worst, fabs((up - down) / (2 * eps) - analytic[i]));
+    }
+    return worst;
+}
+
+int main() {
+    printf("=== Testing layer_norm ===\n\n");
+
+    Arena *arena = arena_create(1 << 22);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    for (int i = 0; i < BIG_M * N; i++) x[i] = 3.0 * sin(0.37 * i) + 100.0 * (i / N % 3);
+    for (int i = 0; i < BIG_M * N; i++) dy[i] = cos(0.61 * i);
+    for (int j = 0; j < N; j++) gamma_[j] = 1.0 + 0.1 * sin(j);
+    for (int j = 0; j < N; j++) beta_[j] = 0.05 * j;
+
+    const char *names[] = {"layer_norm", "rms_norm"};
+    for (int rms = 0; rms < 2; rms++) {
+        char label[96];
+
+        // Test 1: small batches run on the caller and match the reference
+        arena_clear(arena);
+        snprintf(label, sizeof(label), "%s: forward matches reference", names[rms]);
+        check(forward_err(arena, 5, rms) < 1e-12, label);
+
+        // Test 2: gradients match central differences
+        int m = 3;
+        double d_gamma[N], d_beta[N];
+        NormCache cache;
+        double *out = rms ? rms_norm_forward(arena, x, gamma_, m, N, LAYER_NORM_EPS, &cache)
+                          : layer_norm_forward(arena, x, gamma_, beta_, m, N, LAYER_NORM_EPS, &cache);
+        double *dx = rms ? rms_norm_backward(arena, dy, x, gamma_, &cache, m, N, d_gamma)
+                         : layer_norm_backward(arena, dy, x, gamma_, &cache, m, N, d_gamma, d_beta);
+        snprintf(label, sizeof(label), "%s: forward and backward return buffers", names[rms]);
+        check(out && dx, label);
+
+        snprintf(label, sizeof(label), "%s: d_input matches finite differences", names[rms]);
+        check(grad_err(arena, dx, x, m * N, m, rms) < 1e-6, label);
+        snprintf(label, sizeof(label), "%s: d_gamma matches finite differences", names[rms]);
+        check(grad_err(arena, d_gamma, gamma_, N, m, rms) < 1e-6, label);
+        if (!rms)
+            check(grad_err(arena, d_beta, beta_, N, m, rms) < 1e-6, "layer_norm: d_beta matches finite differences");
+
+        // Test 3: a batch above NORM_PARALLEL_MIN is split across threads
+        arena_clear(arena);
+        snprintf(label, sizeof(label), "%s: parallel forward matches reference", names[rms]);
+        check(forward_err(arena, BIG_M, rms) < 1e-12, label);
+
+        double big_gamma[N], big_beta[N], row_gamma[N] = {0}, row_beta[N] = {0};
+        out = rms ? rms_norm_forward(arena, x, gamma_, BIG_M, N, LAYER_NORM_EPS, &cache)
+                  : layer_norm_forward(arena, x, gamma_, beta_, BIG_M, N, LAYER_NORM_EPS, &cache);
+        dx = rms ? rms_norm_backward(arena, dy, x, gamma_, &cache, BIG_M, N, big_gamma)
+                 : layer_norm_backward(arena, dy, x, gamma_, &cache, BIG_M, N, big_gamma, big_beta);
+
+        // each row on its own takes the single-threaded path
+        int same = 1;
+        for (int i = 0; i < BIG_M; i++) {
+            ArenaTemp temp = arena_temp_begin(arena);
+            NormCache rc;
+            double rg[N], rb[N];
+            double *xr = x + i * N, *dr = dy + i * N;
+            double *r = rms ? rms_norm_forward(arena, xr, gamma_, 1, N, LAYER_NORM_EPS, &rc)
+                            : layer_norm_forward(arena, xr, gamma_, beta_, 1, N, LAYER_NORM_EPS, &rc);
+            double *rdx = rms ? rms_norm_backward(arena, dr, xr, gamma_, &rc, 1, N, rg)
+                              : layer_norm_backward(arena, dr, xr, gamma_, &rc, 1, N, rg, rb);
+            for (int j = 0; j < N; j++) {
+                if (r[j] != out[i * N + j] || rdx[j] != dx[i * N + j]) same = 0;
+                row_gamma[j] += rg[j];
+                if (!rms) row_beta[j] += rb[j];
+            }
+            arena_temp_end(temp);
+        }
+        snprintf(label, sizeof(label), "%s: parallel rows equal single-row results", names[rms]);
+        check(same, label);
+
+        double worst = 0.0;
+        for (int j = 0; j < N; j++) {
+            worst = fmax(worst, fabs(big_gamma[j] - row_gamma[j]));
+            if (!rms) worst = fmax(worst, fabs(big_beta[j] - row_beta[j]));
+        }
+        snprintf(label, sizeof(label), "%s: parallel parameter gradients match", names[rms]);
+        check(worst < 1e-9, label);
+    }
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
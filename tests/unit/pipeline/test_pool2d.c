@@ -0,0 +1,72 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/pool2d.h"
+#include "../../../include/arena.h"
+
+#define EPSILON 1e-12
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing pool2d ===\n\n");
+
+    Arena *arena = arena_create(1 << 16);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    // 2 samples, 1 channel, 4x4, 2x2 windows with stride 2
+    double input[32];
+    for (int i = 0; i < 16; i++) input[i] = i;
+    for (int i = 0; i < 16; i++) input[16 + i] = 16 - i;
+    Window2d shape = {1, 4, 4, 2, 2, 0};
+
+    // Test 1: max pooling picks the window maximum and records where
+    int *argmax;
+    double *mx = max_pool2d_forward(arena, input, 2, &shape, &argmax);
+    check(mx[0] == 5 && mx[1] == 7 && mx[2] == 13 && mx[3] == 15, "max of each 2x2 window");
+    check(mx[4] == 16 && mx[7] == 6, "second sample pooled separately");
+    check(argmax[0] == 5 && argmax[3] == 15 && argmax[4] == 0, "argmax holds offsets within the sample");
+
+    // Test 2: max backward routes each gradient to its argmax only
+    double dout[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+    double *dx = max_pool2d_backward(arena, dout, argmax, 2, &shape);
+    double total = 0.0;
+    for (int i = 0; i < 32; i++) total += dx[i];
+    check(dx[5] == 1 && dx[7] == 2 && dx[13] == 3 && dx[15] == 4 && dx[16] == 5, "gradient lands on the winners");
+    check(fabs(total - 36.0) < EPSILON && dx[0] == 0.0, "all other inputs get zero");
+
+    // Test 3: average pooling and its backward
+    double *av = avg_pool2d_forward(arena, input, 2, &shape);
+    check(fabs(av[0] - 2.5) < EPSILON && fabs(av[3] - 12.5) < EPSILON, "mean of each 2x2 window");
+    double *da = avg_pool2d_backward(arena, dout, 2, &shape);
+    check(fabs(da[0] - 0.25) < EPSILON && fabs(da[5] - 0.25) < EPSILON && fabs(da[31] - 2.0) < EPSILON,
+          "average backward spreads gradient evenly");
+
+    // Test 4: overlapping 3x3 windows with stride 1 and padding 1 keep the size
+    Window2d same = {1, 4, 4, 3, 1, 1};
+    double *ms = max_pool2d_forward(arena, input, 1, &same, NULL);
+    check(ms[0] == 5 && ms[15] == 15 && ms[5] == 10, "padded max pooling ignores the border");
+    double *as = avg_pool2d_forward(arena, input, 1, &same);
+    check(fabs(as[0] - (0 + 1 + 4 + 5) / 9.0) < EPSILON, "padded average counts padding as zeros");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
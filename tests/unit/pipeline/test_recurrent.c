@@ -0,0 +1,140 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/pipeline/recurrent.h"
+#include "../../../include/arena.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+#define STEPS 4
+#define M 3
+#define N_IN 5
+#define H 3
+#define MAX_PARAMS ((N_IN + H + 1) * 4 * H)
+
+double params[MAX_PARAMS];
+double input[STEPS * M * N_IN];
+double probe[STEPS * M * H];
+
+// loss = sum(probe * h) over every step
+double loss(Arena *arena, RecurrentLayer *rnn) {
+    ArenaTemp temp = arena_temp_begin(arena);
+    double *h = recurrent_forward(arena, rnn, input, STEPS, M, NULL);
+    double sum = 0.0;
+    for (int i = 0; i < STEPS * M * H; i++) sum += probe[i] * h[i];
+    arena_temp_end(temp);
+    return sum;
+}
+
+double max_rel_err(double *analytic, double *value, int n, Arena *arena, RecurrentLayer *rnn) {
+    double worst = 0.0;
+    for (int i = 0; i < n; i++) {
+        double keep = value[i], eps = 1e-6;
+        value[i] = keep + eps;
+        double up = loss(arena, rnn);
+        value[i] = keep - eps;
+        double down = loss(arena, rnn);
+        value[i] = keep;
+        double numeric = (up - down) / (2 * eps);
+        double err = fabs(numeric - analytic[i]) / fmax(1.0, fabs(numeric));
+        if (err > worst) worst = err;
+    }
+    return worst;
+}
+
+void check_cell(Arena *arena, CellType cell, const char *name) {
+    char label[96];
+    RecurrentLayer rnn;
+    int gh = RECURRENT_GATES(cell) * H;
+
+    recurrent_init(&rnn, cell, params, N_IN, H);
+    for (int i = 0; i < (N_IN + H) * gh; i++) params[i] = 0.6 * sin(0.77 * i + 0.3);
+    for (int j = 0; j < gh; j++) rnn.bias[j] += 0.1 * cos(j);
+
+    RecurrentCache cache;
+    double *h = recurrent_forward(arena, &rnn, input, STEPS, M, &cache);
+    snprintf(label, sizeof(label), "%s: forward returns output", name);
+    check(h != NULL, label);
+
+    // the cached and uncached forward passes agree
+    double *plain = recurrent_forward(arena, &rnn, input, STEPS, M, NULL);
+    int same = 1;
+    for (int i = 0; i < STEPS * M * H; i++)
+        if (plain[i] != h[i]) same = 0;
+    snprintf(label, sizeof(label), "%s: forward without cache matches", name);
+    check(same, label);
+
+    // every gradient matches central differences
+    RecurrentGrad g = recurrent_backward(arena, &rnn, probe, input, h, &cache, STEPS, M);
+    snprintf(label, sizeof(label), "%s: backward returns gradients", name);
+    check(g.d_w_x && g.d_w_h && g.d_bias && g.d_input, label);
+
+    snprintf(label, sizeof(label), "%s: d_w_x matches finite differences", name);
+    check(max_rel_err(g.d_w_x, rnn.w_x, N_IN * gh, arena, &rnn) < 1e-7, label);
+    snprintf(label, sizeof(label), "%s: d_w_h matches finite differences", name);
+    check(max_rel_err(g.d_w_h, rnn.w_h, H * gh, arena, &rnn) < 1e-7, label);
+    snprintf(label, sizeof(label), "%s: d_bias matches finite differences", name);
+    check(max_rel_err(g.d_bias, rnn.bias, gh, arena, &rnn) < 1e-7, label);
+    snprintf(label, sizeof(label), "%s: d_input matches finite differences", name);
+    check(max_rel_err(g.d_input, input, STEPS * M * N_IN, arena, &rnn) < 1e-7, label);
+}
+
+int main() {
+    printf("=== Testing recurrent ===\n\n");
+
+    Arena *arena = arena_create(1 << 20);
+    if (!arena) {
+        printf("Failed to create arena\n");
+        return 1;
+    }
+
+    for (int i = 0; i < STEPS * M * N_IN; i++) input[i] = sin(1.1 * i);
+    for (int i = 0; i < STEPS * M * H; i++) probe[i] = cos(0.45 * i);
+
+    // Test 1: init packs the parameters and opens the LSTM forget gate
+    RecurrentLayer rnn;
+    recurrent_init(&rnn, CELL_LSTM, params, N_IN, H);
+    check(rnn.w_h == params + N_IN * 4 * H && rnn.bias == params + (N_IN + H) * 4 * H,
+          "w_x, w_h and bias are consecutive");
+    check(rnn.bias[0] == 0.0 && rnn.bias[H] == 1.0 && rnn.bias[2 * H] == 0.0,
+          "forget gate bias starts at 1");
+    check(RECURRENT_PARAMS(CELL_GRU, N_IN, H) == (size_t)(N_IN + H + 1) * 3 * H,
+          "GRU packs three gate blocks");
+
+    // Test 2: one LSTM step matches the scalar equations
+    for (int i = 0; i < MAX_PARAMS; i++) params[i] = 0.0;
+    recurrent_init(&rnn, CELL_LSTM, params, N_IN, H);
+    for (int k = 0; k < 4; k++) rnn.w_x[k * H] = 0.5 * (k + 1);
+    double *h = recurrent_forward(arena, &rnn, input, 1, M, NULL);
+    int ok = 1;
+    for (int r = 0; r < M; r++) {
+        double x = input[r * N_IN];
+        double i = 1 / (1 + exp(-0.5 * x));
+        double g = tanh(1.5 * x);
+        double o = 1 / (1 + exp(-2.0 * x));
+        if (fabs(h[r * H] - o * tanh(i * g)) > 1e-12) ok = 0;
+    }
+    check(ok, "LSTM step matches the cell equations");
+
+    // Tests 3-4: GRU and LSTM forward and backward
+    check_cell(arena, CELL_GRU, "GRU");
+    check_cell(arena, CELL_LSTM, "LSTM");
+
+    arena_destroy(arena);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
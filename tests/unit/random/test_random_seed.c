@@ -1,6 +1,6 @@
 #include <stdio.h>
-#include <stdlib.h>
 #include "../../../include/random/random_seed.h"
+#include "../../../include/random/rng.h"
 
 int test_passed = 0;
 int test_failed = 0;
@@ -20,31 +20,31 @@ int main() {
 
     // Test 1: Same seed produces same sequence
     random_seed(42);
-    int a1 = rand();
-    int a2 = rand();
-    int a3 = rand();
+    u64 a1 = rng_next(rng_default());
+    u64 a2 = rng_next(rng_default());
+    u64 a3 = rng_next(rng_default());
 
     random_seed(42);
-    int b1 = rand();
-    int b2 = rand();
-    int b3 = rand();
+    u64 b1 = rng_next(rng_default());
+    u64 b2 = rng_next(rng_default());
+    u64 b3 = rng_next(rng_default());
 
     check(a1 == b1 && a2 == b2 && a3 == b3, "Same seed produces same sequence");
 
     // Test 2: Different seeds produce different sequences
     random_seed(42);
-    int c1 = rand();
+    u64 c1 = rng_next(rng_default());
 
     random_seed(99);
-    int d1 = rand();
+    u64 d1 = rng_next(rng_default());
 
     check(c1 != d1, "Different seeds produce different first values");
 
     // Test 3: Seed of 0 works
     random_seed(0);
-    int e1 = rand();
+    u64 e1 = rng_next(rng_default());
     random_seed(0);
-    int e2 = rand();
+    u64 e2 = rng_next(rng_default());
     check(e1 == e2, "Seed of 0 is reproducible");
 
     printf("\n=== Results ===\n");
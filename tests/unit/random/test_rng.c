@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/random/rng.h"
+#include "../../../include/random/philox.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing rng ===\n\n");
+
+    // Test 1: xoshiro256** reference outputs from the state {1, 2, 3, 4}
+    Rng x = {RNG_XOSHIRO, {1, 2, 3, 4}, {0}, 4};
+    check(rng_next(&x) == 11520ull && rng_next(&x) == 0ull &&
+          rng_next(&x) == 1509978240ull && rng_next(&x) == 1215971899390074240ull,
+          "xoshiro256** matches the reference sequence");
+
+    Rng j = {RNG_XOSHIRO, {1, 2, 3, 4}, {0}, 4};
+    rng_jump(&j);
+    check(rng_next(&j) == 0xBBD2F312298443D8ull && rng_next(&j) == 0x62E57DB2D5706577ull,
+          "jump matches the reference 2^128 skip");
+
+    // Test 2: seeding expands the seed with splitmix64
+    rng_seed(&x, RNG_XOSHIRO, 0);
+    check(x.s[0] == 0xE220A8397B1DCDAFull && x.s[1] == 0x6E789E6AA1B965F4ull,
+          "seed 0 gives the splitmix64 state");
+
+    // Test 3: Philox draws are the words of philox4x32 in counter order
+    Rng p;
+    rng_seed(&p, RNG_PHILOX, 42);
+    u32 words[8];
+    philox_fill(words, 8, 42, 0, 0);
+    int ok = 1;
+    for (int i = 0; i < 4; i++)
+        if (rng_next(&p) != (words[2 * i] | ((u64)words[2 * i + 1] << 32))) ok = 0;
+    check(ok, "Philox draws follow the counter");
+
+    rng_jump(&p);
+    philox_fill(words, 2, 42, 1, 0);
+    check(rng_next(&p) == (words[0] | ((u64)words[1] << 32)), "Philox jump moves to the next stream");
+
+    // Test 4: bulk fills equal one scalar draw per element, from any offset
+    RngKind kinds[2] = {RNG_XOSHIRO, RNG_PHILOX};
+    const char *names[2] = {"xoshiro", "Philox"};
+    for (int k = 0; k < 2; k++) {
+        static double bulk[1000];
+        static float bulk_f[1000];
+        Rng a, b;
+        char label[96];
+
+        rng_seed(&a, kinds[k], 7);
+        rng_seed(&b, kinds[k], 7);
+        rng_next(&a);
+        rng_next(&b);
+        rng_fill_uniform(&a, bulk, 1000, -2.0, 3.0);
+        ok = 1;
+        for (int i = 0; i < 1000; i++)
+            if (bulk[i] != -2.0 + 5.0 * rng_uniform(&b)) ok = 0;
+        ok = ok && rng_next(&a) == rng_next(&b);
+        snprintf(label, sizeof(label), "%s: bulk fill matches scalar draws", names[k]);
+        check(ok, label);
+
+        rng_fill_uniform_f(&a, bulk_f, 1000, 0.0f, 1.0f);
+        ok = 1;
+        double mean = 0.0;
+        for (int i = 0; i < 1000; i++) {
+            if (bulk_f[i] < 0.0f || bulk_f[i] >= 1.0f) ok = 0;
+            mean += bulk_f[i] / 1000;
+        }
+        snprintf(label, sizeof(label), "%s: float fill lies in [0, 1) with mean near 1/2", names[k]);
+        check(ok && fabs(mean - 0.5) < 0.05, label);
+    }
+
+    // Test 5: uniform doubles cover [0, 1) evenly
+    static double u[1 << 16];
+    rng_seed(&x, RNG_XOSHIRO, 123);
+    rng_fill_uniform(&x, u, 1 << 16, 0.0, 1.0);
+    double mean = 0.0, lo = 1.0, hi = 0.0;
+    for (int i = 0; i < (1 << 16); i++) {
+        mean += u[i] / (1 << 16);
+        lo = fmin(lo, u[i]);
+        hi = fmax(hi, u[i]);
+    }
+    check(fabs(mean - 0.5) < 0.01 && lo >= 0.0 && lo < 1e-3 && hi < 1.0 && hi > 0.999,
+          "uniform doubles fill [0, 1)");
+
+    // Test 6: bounded integers stay in range and hit every value
+    int seen[7] = {0};
+    ok = 1;
+    for (int i = 0; i < 7000; i++) {
+        u64 v = rng_below(&x, 7);
+        if (v >= 7) ok = 0;
+        else seen[v]++;
+    }
+    for (int v = 0; v < 7; v++)
+        if (seen[v] < 800 || seen[v] > 1200) ok = 0;
+    check(ok, "rng_below is in range and roughly uniform");
+
+    // Test 7: jumped streams do not repeat the base stream
+    Rng base, s1;
+    rng_seed(&base, RNG_XOSHIRO, 9);
+    s1 = base;
+    rng_jump(&s1);
+    check(rng_next(&base) != rng_next(&s1), "jumped stream differs from the base stream");
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/random/ziggurat.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+#define N (1 << 20)
+
+double z[N];
+
+int main() {
+    printf("=== Testing ziggurat ===\n\n");
+
+    Rng rng;
+    rng_seed(&rng, RNG_XOSHIRO, 2024);
+
+    // Test 1: the first four moments are those of N(0, 1)
+    rng_fill_normal(&rng, z, N, 0.0, 1.0);
+    double m1 = 0.0, m2 = 0.0, m3 = 0.0, m4 = 0.0;
+    for (int i = 0; i < N; i++) {
+        double x = z[i];
+        m1 += x;
+        m2 += x * x;
+        m3 += x * x * x;
+        m4 += x * x * x * x;
+    }
+    m1 /= N; m2 /= N; m3 /= N; m4 /= N;
+    check(fabs(m1) < 0.005, "mean is near 0");
+    check(fabs(m2 - 1.0) < 0.01, "variance is near 1");
+    check(fabs(m3) < 0.02, "skewness is near 0");
+    check(fabs(m4 - 3.0) < 0.05, "kurtosis is near 3");
+
+    // Test 2: the empirical CDF follows Phi, including the wedges and tail
+    double points[] = {-3.0, -1.5, -0.5, 0.0, 0.3, 1.0, 2.2};
+    int cdf_ok = 1;
+    for (int p = 0; p < 7; p++) {
+        int below = 0;
+        for (int i = 0; i < N; i++) below += z[i] < points[p];
+        double phi = 0.5 * erfc(-points[p] / sqrt(2.0));
+        if (fabs((double)below / N - phi) > 0.002) cdf_ok = 0;
+    }
+    check(cdf_ok, "empirical CDF matches the normal CDF");
+
+    int tail = 0;
+    for (int i = 0; i < N; i++) tail += fabs(z[i]) > ZIGGURAT_R;
+    double expect = N * erfc(ZIGGURAT_R / sqrt(2.0));
+    check(fabs(tail - expect) < 5.0 * sqrt(expect), "tail beyond R has the right mass");
+
+    // Test 3: fills are reproducible and scale by mean and std
+    Rng a, b;
+    rng_seed(&a, RNG_PHILOX, 5);
+    rng_seed(&b, RNG_PHILOX, 5);
+    static double x1[1000], x2[1000];
+    rng_fill_normal(&a, x1, 1000, 0.0, 1.0);
+    rng_fill_normal(&b, x2, 1000, 3.0, 0.5);
+    int same = 1;
+    for (int i = 0; i < 1000; i++)
+        if (fabs(x2[i] - (3.0 + 0.5 * x1[i])) > 1e-12) same = 0;
+    check(same, "same state gives the same samples, shifted and scaled");
+
+    static float f[1000];
+    rng_seed(&a, RNG_PHILOX, 5);
+    rng_fill_normal_f(&a, f, 1000, 0.0f, 1.0f);
+    same = 1;
+    for (int i = 0; i < 1000; i++)
+        if (fabs(f[i] - x1[i]) > 1e-6) same = 0;
+    check(same, "float fill matches the double fill");
+
+    // Test 4: scalar draws are normal too
+    double s1 = 0.0, s2 = 0.0;
+    for (int i = 0; i < 100000; i++) {
+        double x = rng_normal(&rng);
+        s1 += x;
+        s2 += x * x;
+    }
+    check(fabs(s1 / 100000) < 0.02 && fabs(s2 / 100000 - 1.0) < 0.03, "rng_normal has mean 0 and variance 1");
+
+    // Test 5: truncated samples stay inside the bounds
+    rng_fill_truncated_normal(&rng, z, N, 1.0, 2.0, -3.0, 5.0);
+    int inside = 1;
+    double tm = 0.0;
+    for (int i = 0; i < N; i++) {
+        if (z[i] < -3.0 || z[i] > 5.0) inside = 0;
+        tm += z[i] / N;
+    }
+    check(inside, "truncated samples lie in [lo, hi]");
+    check(fabs(tm - 1.0) < 0.01, "symmetric truncation keeps the mean");
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
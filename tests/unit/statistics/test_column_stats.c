@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/statistics/column_stats.h"
+
+#define EPSILON 1e-9
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing column_moments ===\n\n");
+
+    // Test 1: known per-column mean and population variance
+    // col 0 = {1, 2, 3}: mean 2, var 2/3; col 1 = {10, 10, 10}: mean 10, var 0
+    double x1[] = {1.0, 10.0, 2.0, 10.0, 3.0, 10.0};
+    double mean[3], var[3];
+    column_moments(x1, 3, 2, mean, var);
+    check(fabs(mean[0] - 2.0) < EPSILON && fabs(mean[1] - 10.0) < EPSILON, "Column means");
+    check(fabs(var[0] - 2.0 / 3.0) < EPSILON, "Population variance");
+    check(fabs(var[1]) < EPSILON, "Constant column has zero variance");
+
+    // Test 2: matches a two-pass computation on a wider matrix
+    double x2[50 * 3];
+    for (int i = 0; i < 150; i++) x2[i] = sin(0.37 * i) * (1 + i % 3);
+    column_moments(x2, 50, 3, mean, var);
+    int ok = 1;
+    for (int j = 0; j < 3; j++) {
+        double s = 0.0, v = 0.0;
+        for (int i = 0; i < 50; i++) s += x2[i * 3 + j];
+        s /= 50;
+        for (int i = 0; i < 50; i++) v += (x2[i * 3 + j] - s) * (x2[i * 3 + j] - s);
+        v /= 50;
+        if (fabs(mean[j] - s) > EPSILON || fabs(var[j] - v) > EPSILON) ok = 0;
+    }
+    check(ok, "Matches two-pass mean and variance");
+
+    // Test 3: a large offset does not cancel the variance away
+    double x3[4];
+    for (int i = 0; i < 4; i++) x3[i] = 1e9 + i;
+    column_moments(x3, 4, 1, mean, var);
+    check(fabs(var[0] - 1.25) < 1e-6, "Stable under a large offset");
+
+    // Test 4: zero rows leave zeros
+    column_moments(x3, 0, 1, mean, var);
+    check(mean[0] == 0.0 && var[0] == 0.0, "Empty input gives zero moments");
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
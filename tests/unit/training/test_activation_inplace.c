@@ -0,0 +1,62 @@
+#include <stdio.h>
+#include <math.h>
+#include "../../../include/training/activation_inplace.h"
+
+#define EPSILON 1e-10
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing activation_inplace ===\n\n");
+
+    // Test 1: relu forward, then backward masks with the activated output
+    double h[] = {-1.0, 0.0, 2.0, -3.0};
+    activation_forward_inplace(h, 2, 2, ACTIVATION_RELU);
+    check(h[0] == 0.0 && h[1] == 0.0 && h[2] == 2.0 && h[3] == 0.0, "relu forward in place");
+
+    double g[] = {1.0, 1.0, 1.0, 1.0};
+    activation_backward_inplace(g, h, 4, ACTIVATION_RELU);
+    check(g[0] == 0.0 && g[1] == 0.0 && g[2] == 1.0 && g[3] == 0.0, "relu backward from the output");
+
+    // Test 2: sigmoid forward and backward
+    double s[] = {0.0};
+    activation_forward_inplace(s, 1, 1, ACTIVATION_SIGMOID);
+    check(fabs(s[0] - 0.5) < EPSILON, "sigmoid forward in place");
+
+    double gs[] = {2.0};
+    activation_backward_inplace(gs, s, 1, ACTIVATION_SIGMOID);
+    check(fabs(gs[0] - 0.5) < EPSILON, "sigmoid backward scales by s(1 - s)");
+
+    // Test 3: softmax rows sum to one; backward leaves the gradient untouched
+    double z[] = {1.0, 2.0, 3.0, 0.0, 0.0, 0.0};
+    activation_forward_inplace(z, 2, 3, ACTIVATION_SOFTMAX);
+    check(fabs(z[0] + z[1] + z[2] - 1.0) < EPSILON && fabs(z[3] - 1.0 / 3.0) < EPSILON,
+          "softmax forward normalizes each row");
+    check(z[2] > z[1] && z[1] > z[0], "softmax keeps order");
+
+    double gz[] = {0.1, -0.2, 0.1};
+    activation_backward_inplace(gz, z, 3, ACTIVATION_SOFTMAX);
+    check(gz[0] == 0.1 && gz[1] == -0.2, "softmax backward passes the combined gradient through");
+
+    // Test 4: ACTIVATION_NONE is the identity
+    double n[] = {-5.0, 5.0};
+    activation_forward_inplace(n, 1, 2, ACTIVATION_NONE);
+    check(n[0] == -5.0 && n[1] == 5.0, "none forward is identity");
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,100 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../../include/training/hogwild_trainer.h"
+#include "../../../include/training/trainer.h"
+#include "../../../include/random/random_seed.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing hogwild_trainer ===\n\n");
+
+    // sparse linear regression: 32 features, at most 2 non-zeros per sample
+    int n = 256, d = 32;
+    double w_true[32];
+    for (int j = 0; j < d; j++) w_true[j] = ((j * 5) % 7 - 3) / 10.0;
+
+    double *x = calloc(n * d, sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        int a = i % d;
+        int b = (i * 7 + 3) % d;
+        x[i * d + a] = 1.0;
+        x[i * d + b] += 0.5;
+        y[i] = 0.0;
+        for (int j = 0; j < d; j++) y[i] += w_true[j] * x[i * d + j];
+    }
+
+    // Test 1: one thread follows exactly the synchronous trainer
+    double ws[32] = {0}, wh[32] = {0};
+    DenseLayer sync_layer[] = {{ws, d, 1, ACTIVATION_NONE}};
+    DenseLayer hog_layer[] = {{wh, d, 1, ACTIVATION_NONE}};
+
+    Trainer *st = trainer_create(sync_layer, 1, LOSS_MSE, 8, 0.2);
+    HogwildTrainer *ht = hogwild_trainer_create(hog_layer, 1, LOSS_MSE, 8, 0.2, 1);
+    check(ht != NULL, "hogwild_trainer_create returns trainer");
+
+    BatchIterator *its = batch_iterator_create(x, y, n, d, 1, 8);
+    BatchIterator *ith = batch_iterator_create(x, y, n, d, 1, 8);
+
+    EpochStats ss = {0}, hs = {0};
+    for (int e = 0; e < 3; e++) {
+        random_seed(11 + e);
+        ss = train_epoch(st, its);
+        random_seed(11 + e);
+        hs = hogwild_train_epoch(ht, ith);
+    }
+
+    int same = fabs(ss.loss - hs.loss) < 1e-9;
+    for (int i = 0; i < d; i++)
+        if (fabs(ws[i] - wh[i]) > 1e-9) same = 0;
+    check(same, "1 thread: matches synchronous training");
+    check(hs.n_steps == 32 && hs.n_samples == n, "1 thread: epoch covers every sample");
+
+    hogwild_trainer_destroy(ht);
+    trainer_destroy(st);
+
+    // Test 2: four racing workers still converge
+    double w4[32] = {0};
+    DenseLayer layer4[] = {{w4, d, 1, ACTIVATION_NONE}};
+    ht = hogwild_trainer_create(layer4, 1, LOSS_MSE, 8, 0.2, 4);
+
+    random_seed(5);
+    EpochStats first = hogwild_train_epoch(ht, ith);
+    EpochStats last = first;
+    for (int e = 0; e < 100; e++)
+        last = hogwild_train_epoch(ht, ith);
+
+    check(last.n_samples == n, "4 threads: every sample is trained once per epoch");
+    check(last.loss < 0.05 * first.loss, "4 threads: loss converges");
+
+    BatchIterator *big = batch_iterator_create(x, y, n, d, 1, 16);
+    check(hogwild_train_epoch(ht, big).n_steps == -1, "oversized iterator batch is rejected with n_steps = -1");
+    batch_iterator_destroy(big);
+
+    hogwild_trainer_destroy(ht);
+
+    check(hogwild_trainer_create(layer4, 1, LOSS_MSE, 8, 0.2, 0) == NULL, "zero threads is rejected");
+
+    batch_iterator_destroy(its);
+    batch_iterator_destroy(ith);
+    free(x); free(y);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
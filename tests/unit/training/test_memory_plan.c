@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include "../../../include/training/memory_plan.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int no_live_overlap(MemoryPlan *plan) {
+    for (int i = 0; i < plan->n_buffers; i++) {
+        for (int j = i + 1; j < plan->n_buffers; j++) {
+            PlanBuffer *a = &plan->buffers[i];
+            PlanBuffer *b = &plan->buffers[j];
+            int live = a->first <= b->last && b->first <= a->last;
+            int mem = a->offset < b->offset + b->size && b->offset < a->offset + a->size;
+            if (live && mem) return 0;
+        }
+    }
+    return 1;
+}
+
+int main() {
+    printf("=== Testing memory_plan ===\n\n");
+
+    // Test 1: single layer, 4 x 3 -> 2, batch 5
+    DenseLayer one[] = {{NULL, 3, 2, ACTIVATION_SIGMOID}};
+    MemoryPlan *plan = memory_plan_create(one, 1, 5);
+    check(plan != NULL, "memory_plan_create returns plan");
+    check(plan->n_buffers == 5, "input, target, hidden, grad, d_weights buffers");
+    check(plan->buffers[plan->hidden[0]].size >= 5 * 2 * sizeof(double), "hidden buffer holds m x p");
+    check(plan->buffers[plan->d_weights[0]].size >= 3 * 2 * sizeof(double), "d_weights buffer holds n x p");
+    check(no_live_overlap(plan), "single layer: live buffers never overlap");
+
+    int aligned = 1;
+    for (int i = 0; i < plan->n_buffers; i++)
+        if (plan->buffers[i].offset % PLAN_ALIGNMENT != 0) aligned = 0;
+    check(aligned, "offsets are PLAN_ALIGNMENT aligned");
+    memory_plan_destroy(plan);
+
+    // Test 2: deep MLP reuses memory across layers
+    DenseLayer deep[] = {
+        {NULL, 784, 256, ACTIVATION_RELU},
+        {NULL, 256, 256, ACTIVATION_RELU},
+        {NULL, 256, 256, ACTIVATION_RELU},
+        {NULL, 256, 256, ACTIVATION_RELU},
+        {NULL, 256, 10, ACTIVATION_SOFTMAX},
+    };
+    plan = memory_plan_create(deep, 5, 64);
+    check(no_live_overlap(plan), "deep MLP: live buffers never overlap");
+    check(plan->total_bytes < plan->naive_bytes, "deep MLP: liveness reuse beats no-reuse size");
+
+    u64 largest = 0;
+    u64 end = 0;
+    for (int i = 0; i < plan->n_buffers; i++) {
+        if (plan->buffers[i].size > largest) largest = plan->buffers[i].size;
+        if (plan->buffers[i].offset + plan->buffers[i].size > end)
+            end = plan->buffers[i].offset + plan->buffers[i].size;
+    }
+    check(plan->total_bytes >= largest, "total covers the largest buffer");
+    check(plan->total_bytes == end, "total is the highest buffer end");
+
+    // Test 3: buffer pointers resolve relative to the base
+    double storage[1];
+    double *h0 = memory_plan_buffer(plan, storage, plan->hidden[0]);
+    check((char *)h0 - (char *)storage == (long)plan->buffers[plan->hidden[0]].offset,
+          "memory_plan_buffer applies the planned offset");
+
+    memory_plan_destroy(plan);
+
+    // Test 4: checkpointing every 4 of 16 layers keeps O(sqrt L) activations live
+    DenseLayer stack[16];
+    for (int l = 0; l < 16; l++) {
+        stack[l].weights = NULL;
+        stack[l].n_in = 256;
+        stack[l].n_out = 256;
+        stack[l].act = ACTIVATION_RELU;
+    }
+    MemoryPlan *full = memory_plan_create(stack, 16, 64);
+    MemoryPlan *ckpt = memory_plan_create_checkpointed(stack, 16, 64, 4);
+    check(ckpt != NULL && ckpt->checkpoint_every == 4, "memory_plan_create_checkpointed returns plan");
+    check(no_live_overlap(ckpt), "checkpointed: live buffers never overlap");
+    check(ckpt->n_ops == full->n_ops + 12, "three layers recomputed per segment");
+    check(ckpt->recompute[3] < 0 && ckpt->recompute[15] < 0 && ckpt->recompute[4] >= 0,
+          "only segment ends are checkpoints");
+    u64 activation = 64 * 256 * sizeof(double);
+    check(ckpt->total_bytes + 8 * activation <= full->total_bytes, "checkpointed plan holds 8 fewer activations");
+    memory_plan_destroy(full);
+    memory_plan_destroy(ckpt);
+
+    check(memory_plan_create_checkpointed(one, 1, 5, 0) == NULL, "checkpoint interval below 1 rejected");
+    check(memory_plan_create(one, 0, 5) == NULL, "zero layers rejected");
+    check(memory_plan_create(one, 1, 0) == NULL, "batch size below 1 rejected");
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,91 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../../include/training/minibatch.h"
+
+#define EPSILON 1e-9
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing minibatch ===\n\n");
+
+    // 10 samples, 2 features, 1 target; feature 0 encodes the sample index
+    double features[20];
+    double targets[10];
+    for (int i = 0; i < 10; i++) {
+        features[i * 2] = i;
+        features[i * 2 + 1] = 10.0 * i;
+        targets[i] = -i;
+    }
+
+    BatchIterator *it = batch_iterator_create(features, targets, 10, 2, 1, 4);
+    check(it != NULL, "batch_iterator_create returns iterator");
+
+    // Test 1: unshuffled iteration keeps dataset order and yields a short tail batch
+    double x[8], y[4];
+    int rows = batch_iterator_next(it, x, y);
+    check(rows == 4, "first batch has batch_size rows");
+    check(fabs(x[0] - 0.0) < EPSILON && fabs(x[6] - 3.0) < EPSILON, "first batch in dataset order");
+
+    rows = batch_iterator_next(it, x, y);
+    check(rows == 4, "second batch has batch_size rows");
+    rows = batch_iterator_next(it, x, y);
+    check(rows == 2, "last batch holds the remainder");
+    rows = batch_iterator_next(it, x, y);
+    check(rows == 0, "iterator returns 0 at end of epoch");
+
+    // Test 2: shuffled epoch visits every sample exactly once, rows stay paired
+    srand(7);
+    batch_iterator_shuffle(it);
+    int seen[10] = {0};
+    int paired = 1;
+    int total = 0;
+    while ((rows = batch_iterator_next(it, x, y)) > 0) {
+        for (int r = 0; r < rows; r++) {
+            int idx = (int)x[r * 2];
+            seen[idx]++;
+            if (fabs(x[r * 2 + 1] - 10.0 * idx) > EPSILON || fabs(y[r] + idx) > EPSILON)
+                paired = 0;
+        }
+        total += rows;
+    }
+    int once = 1;
+    for (int i = 0; i < 10; i++)
+        if (seen[i] != 1) once = 0;
+    check(total == 10, "shuffled epoch covers all samples");
+    check(once, "shuffled epoch visits each sample once");
+    check(paired, "features and targets stay paired after shuffle");
+
+    // Test 3: reset restarts the epoch in the current order
+    batch_iterator_reset(it);
+    check(batch_iterator_next(it, x, NULL) == 4, "reset restarts iteration (targets optional)");
+
+    // Test 4: shared claiming hands out disjoint batches and stops at the end
+    batch_iterator_reset(it);
+    check(batch_iterator_next_shared(it, x, y) == 4, "shared: first claim is a full batch");
+    check(fabs(x[0] - features[it->order[0] * 2]) < EPSILON, "shared: first claim starts the epoch");
+    check(batch_iterator_next_shared(it, x, y) == 4, "shared: second claim is a full batch");
+    check(batch_iterator_next_shared(it, x, y) == 2, "shared: last claim holds the remainder");
+    check(batch_iterator_next_shared(it, x, y) == 0, "shared: claims past the end return 0");
+    check(batch_iterator_next_shared(it, x, y) == 0, "shared: repeated claims past the end return 0");
+
+    batch_iterator_destroy(it);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
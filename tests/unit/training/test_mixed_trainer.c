@@ -0,0 +1,121 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../../include/training/mixed_trainer.h"
+#include "../../../include/training/trainer.h"
+#include "../../../include/pipeline/init_weights.h"
+#include "../../../include/random/random_seed.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing mixed_trainer ===\n\n");
+
+    int m = 40;
+    double *x = malloc(m * 2 * sizeof(double));
+    double *y = calloc(m * 2, sizeof(double));
+    for (int i = 0; i < m; i++) {
+        double a = (i % 10) / 10.0 - 0.5;
+        double b = (i / 10) / 4.0 - 0.4;
+        x[i * 2] = a;
+        x[i * 2 + 1] = b;
+        y[i * 2 + (a > 0.0 ? 1 : 0)] = 1.0;
+    }
+
+    random_seed(3);
+    double *w1 = init_weights(2 * 8, 0.0, 0.5);
+    double *w2 = init_weights(8 * 2, 0.0, 0.5);
+
+    // Test 1: float32 steps track the double trainer closely
+    double ra[16], ra2[16], ma[16], ma2[16];
+    for (int i = 0; i < 16; i++) {
+        ra[i] = ma[i] = w1[i];
+        ra2[i] = ma2[i] = w2[i];
+    }
+    DenseLayer ref[] = {{ra, 2, 8, ACTIVATION_RELU}, {ra2, 8, 2, ACTIVATION_SOFTMAX}};
+    DenseLayer mix[] = {{ma, 2, 8, ACTIVATION_RELU}, {ma2, 8, 2, ACTIVATION_SOFTMAX}};
+
+    Trainer *t = trainer_create(ref, 2, LOSS_CROSS_ENTROPY, 10, 0.5);
+    MixedTrainer *mt = mixed_trainer_create(mix, 2, LOSS_CROSS_ENTROPY, 10, 0.5);
+    check(mt != NULL, "mixed_trainer_create returns trainer");
+
+    double rl = 0.0, ml = 0.0;
+    for (int s = 0; s < 4; s++) {
+        rl = train_step(t, x + s * 20, y + s * 20, 10);
+        ml = mixed_train_step(mt, x + s * 20, y + s * 20, 10);
+    }
+
+    int close = fabs(rl - ml) < 1e-5;
+    for (int i = 0; i < 16; i++)
+        if (fabs(ra[i] - ma[i]) > 1e-5 || fabs(ra2[i] - ma2[i]) > 1e-5) close = 0;
+    check(close, "float32 steps match double steps to float precision");
+    check(mt->n_skipped == 0, "no steps skipped at the initial scale");
+
+    // Test 2: an overflowing scale skips the step and halves the scale
+    double before[16];
+    for (int i = 0; i < 16; i++) before[i] = ma[i];
+    mt->loss_scale = 1e300;
+    mixed_train_step(mt, x, y, 10);
+
+    int unchanged = 1;
+    for (int i = 0; i < 16; i++)
+        if (ma[i] != before[i]) unchanged = 0;
+    check(unchanged, "overflowed step leaves master weights unchanged");
+    check(mt->n_skipped == 1 && mt->loss_scale == 5e299, "overflow halves the loss scale");
+
+    // Test 3: an overflowed delta is caught even when zero inputs hide it from dw
+    double zw[2] = {0.5, -0.5};
+    double zx[4] = {0.0, 0.0, 0.0, 0.0};
+    double zy[2] = {1.0, 2.0};
+    DenseLayer zlin[] = {{zw, 2, 1, ACTIVATION_NONE}};
+    MixedTrainer *zt = mixed_trainer_create(zlin, 1, LOSS_MSE, 2, 0.1);
+    zt->loss_scale = 1e300;
+    mixed_train_step(zt, zx, zy, 2);
+    check(zt->n_skipped == 1 && zw[0] == 0.5 && zw[1] == -0.5, "overflow with zero inputs still skips the step");
+    mixed_trainer_destroy(zt);
+
+    // Test 4: the scale doubles after growth_interval good steps
+    mt->loss_scale = 1024.0;
+    mt->growth_interval = 3;
+    mt->good_steps = 0;
+    for (int s = 0; s < 3; s++)
+        mixed_train_step(mt, x, y, 10);
+    check(mt->loss_scale == 2048.0 && mt->good_steps == 0, "scale doubles after growth_interval steps");
+
+    // Test 5: epochs train the classifier
+    mt->growth_interval = MIXED_GROWTH_INTERVAL;
+    BatchIterator *it = batch_iterator_create(x, y, m, 2, 2, 10);
+    EpochStats first = mixed_train_epoch(mt, it);
+    EpochStats last = first;
+    for (int e = 0; e < 300; e++)
+        last = mixed_train_epoch(mt, it);
+    check(last.loss < 0.5 * first.loss, "mixed-precision epochs reduce the loss");
+
+    BatchIterator *big = batch_iterator_create(x, y, m, 2, 2, 20);
+    check(mixed_train_epoch(mt, big).n_steps == -1, "oversized iterator batch is rejected with n_steps = -1");
+    batch_iterator_destroy(big);
+
+    batch_iterator_destroy(it);
+    mixed_trainer_destroy(mt);
+    trainer_destroy(t);
+
+    free(w1); free(w2);
+    free(x); free(y);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
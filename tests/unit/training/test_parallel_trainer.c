@@ -0,0 +1,149 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../../include/training/parallel_trainer.h"
+#include "../../../include/training/trainer.h"
+#include "../../../include/pipeline/init_weights.h"
+#include "../../../include/random/random_seed.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+//resident set size in MB, -1 where /proc is not available
+static long rss_mb(void) {
+    long pages = -1, resident = -1;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (!f) return -1;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = -1;
+    fclose(f);
+    return resident < 0 ? -1 : resident * 4096 / (1024 * 1024);
+}
+
+int main() {
+    printf("=== Testing parallel_trainer ===\n\n");
+
+    int m = 40;
+    double *x = malloc(m * 2 * sizeof(double));
+    double *y = calloc(m * 2, sizeof(double));
+    for (int i = 0; i < m; i++) {
+        double a = (i % 10) / 10.0 - 0.5;
+        double b = (i / 10) / 4.0 - 0.4;
+        x[i * 2] = a;
+        x[i * 2 + 1] = b;
+        y[i * 2 + (a > 0.0 ? 1 : 0)] = 1.0;
+    }
+
+    random_seed(3);
+    double *w1 = init_weights(2 * 8, 0.0, 0.5);
+    double *w2 = init_weights(8 * 2, 0.0, 0.5);
+
+    // Test 1: a step on N threads matches the single-threaded trainer
+    int thread_counts[] = {1, 2, 3, 7};
+    for (int c = 0; c < 4; c++) {
+        double ra[16], ra2[16], pa[16], pa2[16];
+        for (int i = 0; i < 16; i++) {
+            ra[i] = pa[i] = w1[i];
+            ra2[i] = pa2[i] = w2[i];
+        }
+        DenseLayer ref[] = {{ra, 2, 8, ACTIVATION_RELU}, {ra2, 8, 2, ACTIVATION_SOFTMAX}};
+        DenseLayer par[] = {{pa, 2, 8, ACTIVATION_RELU}, {pa2, 8, 2, ACTIVATION_SOFTMAX}};
+
+        Trainer *t = trainer_create(ref, 2, LOSS_CROSS_ENTROPY, 10, 0.5);
+        ParallelTrainer *pt = parallel_trainer_create(par, 2, LOSS_CROSS_ENTROPY, 10, 0.5, thread_counts[c]);
+
+        double rl = 0.0, pl = 0.0;
+        for (int s = 0; s < 3; s++) {
+            rl = train_step(t, x + s * 20, y + s * 20, 10);
+            pl = parallel_train_step(pt, x + s * 20, y + s * 20, 10);
+        }
+
+        int same = fabs(rl - pl) < 1e-10;
+        for (int i = 0; i < 16; i++)
+            if (fabs(ra[i] - pa[i]) > 1e-10 || fabs(ra2[i] - pa2[i]) > 1e-10) same = 0;
+
+        char name[64];
+        snprintf(name, sizeof(name), "%d thread(s): matches single-threaded step", thread_counts[c]);
+        check(same, name);
+
+        parallel_trainer_destroy(pt);
+        trainer_destroy(t);
+    }
+
+    // Test 2: MSE epochs converge with more threads than rows in the last batch
+    int n = 66;
+    double *lx = malloc(n * 2 * sizeof(double));
+    double *ly = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        lx[i * 2] = (i % 8) / 8.0;
+        lx[i * 2 + 1] = (i / 8) / 8.0;
+        ly[i] = 2.0 * lx[i * 2] - lx[i * 2 + 1];
+    }
+
+    double w[2] = {0.0, 0.0};
+    DenseLayer lin[] = {{w, 2, 1, ACTIVATION_NONE}};
+    ParallelTrainer *pt = parallel_trainer_create(lin, 1, LOSS_MSE, 8, 0.5, 4);
+    check(pt != NULL, "parallel_trainer_create returns trainer");
+
+    BatchIterator *it = batch_iterator_create(lx, ly, n, 2, 1, 8);
+    EpochStats first = parallel_train_epoch(pt, it);
+    EpochStats last = first;
+    for (int e = 0; e < 200; e++)
+        last = parallel_train_epoch(pt, it);
+
+    check(first.n_steps == 9 && first.n_samples == 66, "epoch covers every sample");
+    check(last.loss < first.loss, "loss decreases across epochs");
+    check(fabs(w[0] - 2.0) < 0.05 && fabs(w[1] + 1.0) < 0.05, "weights converge to target");
+
+    BatchIterator *wide_it = batch_iterator_create(lx, ly, n, 2, 1, 16);
+    check(parallel_train_epoch(pt, wide_it).n_steps == -1, "oversized iterator batch is rejected with n_steps = -1");
+    batch_iterator_destroy(wide_it);
+
+    batch_iterator_destroy(it);
+    parallel_trainer_destroy(pt);
+
+    check(parallel_trainer_create(lin, 1, LOSS_MSE, 8, 0.5, 0) == NULL, "zero threads is rejected");
+
+    // Test 3: activations that overflow a worker arena's first block are released every step
+    int bm = 256, wide = 512;
+    double *bx = malloc((size_t)bm * 64 * sizeof(double));
+    double *by = malloc((size_t)bm * sizeof(double));
+    for (int i = 0; i < bm * 64; i++) bx[i] = (i % 13) / 13.0 - 0.5;
+    for (int i = 0; i < bm; i++) by[i] = (i % 7) / 7.0;
+
+    double *bw1 = init_weights(64 * wide, 0.0, 0.05);
+    double *bw2 = init_weights(wide, 0.0, 0.05);
+    DenseLayer big[] = {{bw1, 64, wide, ACTIVATION_RELU}, {bw2, wide, 1, ACTIVATION_NONE}};
+    pt = parallel_trainer_create(big, 2, LOSS_MSE, bm, 0.01, 1);
+
+    parallel_train_step(pt, bx, by, bm);
+    long before = rss_mb();
+    int finite = 1;
+    for (int s = 0; s < 100; s++)
+        if (!isfinite(parallel_train_step(pt, bx, by, bm))) finite = 0;
+    long after = rss_mb();
+
+    check(finite, "100 steps with multi-block worker arenas stay finite");
+    check(before < 0 || after - before < 64, "resident memory stays flat across steps");
+
+    parallel_trainer_destroy(pt);
+    free(bw1); free(bw2); free(bx); free(by);
+
+    free(w1); free(w2);
+    free(x); free(y); free(lx); free(ly);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,198 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include "../../../include/training/trainer.h"
+#include "../../../include/pipeline/init_weights.h"
+#include "../../../include/random/random_seed.h"
+
+int test_passed = 0;
+int test_failed = 0;
+
+void check(int condition, const char *test_name) {
+    if (condition) {
+        printf("[PASS] %s\n", test_name);
+        test_passed++;
+    } else {
+        printf("[FAIL] %s\n", test_name);
+        test_failed++;
+    }
+}
+
+int main() {
+    printf("=== Testing trainer ===\n\n");
+
+    // Test 1: linear regression y = 2*x0 - x1 with one ACTIVATION_NONE layer
+    int n = 64;
+    double *x = malloc(n * 2 * sizeof(double));
+    double *y = malloc(n * sizeof(double));
+    for (int i = 0; i < n; i++) {
+        x[i * 2] = (i % 8) / 8.0;
+        x[i * 2 + 1] = (i / 8) / 8.0;
+        y[i] = 2.0 * x[i * 2] - x[i * 2 + 1];
+    }
+
+    random_seed(1);
+    double w[2] = {0.0, 0.0};
+    DenseLayer lin[] = {{w, 2, 1, ACTIVATION_NONE}};
+
+    Trainer *t = trainer_create(lin, 1, LOSS_MSE, 8, 0.5);
+    check(t != NULL, "trainer_create returns trainer");
+
+    BatchIterator *it = batch_iterator_create(x, y, n, 2, 1, 8);
+    EpochStats first = train_epoch(t, it);
+    EpochStats last = first;
+    for (int e = 0; e < 200; e++)
+        last = train_epoch(t, it);
+
+    check(first.n_steps == 8 && first.n_samples == 64, "epoch runs n_samples / batch_size steps");
+    check(last.loss < first.loss, "loss decreases across epochs");
+    check(fabs(w[0] - 2.0) < 0.05 && fabs(w[1] + 1.0) < 0.05, "weights converge to target");
+    check(last.samples_per_sec > 0.0, "samples_per_sec reported");
+    check(t->arena->capacity == t->plan->total_bytes, "arena is sized exactly from the memory plan");
+
+    batch_iterator_destroy(it);
+    trainer_destroy(t);
+
+    // Test 2: two-layer relu + softmax classifier with cross-entropy
+    int m = 40;
+    double *cx = malloc(m * 2 * sizeof(double));
+    double *cy = calloc(m * 2, sizeof(double));
+    for (int i = 0; i < m; i++) {
+        double a = (i % 10) / 10.0 - 0.5;
+        double b = (i / 10) / 4.0 - 0.4;
+        cx[i * 2] = a;
+        cx[i * 2 + 1] = b;
+        cy[i * 2 + (a > 0.0 ? 1 : 0)] = 1.0;
+    }
+
+    random_seed(3);
+    double *w1 = init_weights(2 * 8, 0.0, 0.5);
+    double *w2 = init_weights(8 * 2, 0.0, 0.5);
+    DenseLayer mlp[] = {
+        {w1, 2, 8, ACTIVATION_RELU},
+        {w2, 8, 2, ACTIVATION_SOFTMAX},
+    };
+
+    t = trainer_create(mlp, 2, LOSS_CROSS_ENTROPY, 10, 0.5);
+    it = batch_iterator_create(cx, cy, m, 2, 2, 10);
+    first = train_epoch(t, it);
+    for (int e = 0; e < 300; e++)
+        last = train_epoch(t, it);
+
+    check(last.loss < 0.5 * first.loss, "softmax + cross-entropy MLP trains on mini-batches");
+
+    // Test 3: iterator batch larger than the trainer's buffers is rejected
+    BatchIterator *big = batch_iterator_create(cx, cy, m, 2, 2, 20);
+    EpochStats none = train_epoch(t, big);
+    check(none.n_steps == -1 && none.n_samples == 0, "oversized iterator batch is rejected with n_steps = -1");
+
+    batch_iterator_destroy(big);
+    batch_iterator_destroy(it);
+    trainer_destroy(t);
+
+    // Test 4: accumulating micro-batches matches one large-batch step
+    double wa[2 * 8], wb[2 * 8];
+    double wa2[8 * 2], wb2[8 * 2];
+    for (int i = 0; i < 16; i++) {
+        wa[i] = wb[i] = w1[i];
+        wa2[i] = wb2[i] = w2[i];
+    }
+    DenseLayer big_mlp[] = {{wa, 2, 8, ACTIVATION_RELU}, {wa2, 8, 2, ACTIVATION_SOFTMAX}};
+    DenseLayer acc_mlp[] = {{wb, 2, 8, ACTIVATION_RELU}, {wb2, 8, 2, ACTIVATION_SOFTMAX}};
+
+    Trainer *tb = trainer_create(big_mlp, 2, LOSS_CROSS_ENTROPY, 12, 0.5);
+    Trainer *ta = trainer_create(acc_mlp, 2, LOSS_CROSS_ENTROPY, 4, 0.5);
+    check(trainer_set_accumulation(ta, 3) == 0, "trainer_set_accumulation succeeds");
+
+    train_step(tb, cx, cy, 12);
+    train_accumulate(ta, cx, cy, 4);
+    train_accumulate(ta, cx + 8, cy + 8, 4);
+    train_accumulate(ta, cx + 16, cy + 16, 3);
+    train_accumulate(ta, cx + 22, cy + 22, 1);
+    train_apply(ta);
+
+    int same = 1;
+    for (int i = 0; i < 16; i++)
+        if (fabs(wa[i] - wb[i]) > 1e-12 || fabs(wa2[i] - wb2[i]) > 1e-12) same = 0;
+    check(same, "uneven micro-batches accumulate to the large-batch update");
+
+    // Test 5: train_accumulate without trainer_set_accumulation allocates its buffers
+    double wc[2 * 8], wd[2 * 8];
+    double wc2[8 * 2], wd2[8 * 2];
+    for (int i = 0; i < 16; i++) {
+        wc[i] = wd[i] = w1[i];
+        wc2[i] = wd2[i] = w2[i];
+    }
+    DenseLayer step_mlp[] = {{wc, 2, 8, ACTIVATION_RELU}, {wc2, 8, 2, ACTIVATION_SOFTMAX}};
+    DenseLayer lazy_mlp[] = {{wd, 2, 8, ACTIVATION_RELU}, {wd2, 8, 2, ACTIVATION_SOFTMAX}};
+    Trainer *ts = trainer_create(step_mlp, 2, LOSS_CROSS_ENTROPY, 8, 0.5);
+    Trainer *tl = trainer_create(lazy_mlp, 2, LOSS_CROSS_ENTROPY, 4, 0.5);
+
+    train_apply(tl);
+    train_step(ts, cx, cy, 8);
+    double lazy_loss = train_accumulate(tl, cx, cy, 4);
+    train_accumulate(tl, cx + 8, cy + 8, 4);
+    train_apply(tl);
+
+    same = isfinite(lazy_loss);
+    for (int i = 0; i < 16; i++)
+        if (fabs(wc[i] - wd[i]) > 1e-12 || fabs(wc2[i] - wd2[i]) > 1e-12) same = 0;
+    check(same, "accumulating on a fresh trainer matches one large-batch step");
+
+    trainer_destroy(tl);
+    trainer_destroy(ts);
+
+    // Test 6: train_epoch steps once per accumulation group
+    it = batch_iterator_create(cx, cy, m, 2, 2, 4);
+    EpochStats acc_first = train_epoch(ta, it);
+    check(acc_first.n_steps == 4 && acc_first.n_samples == 40, "10 micro-batches in groups of 3 take 4 steps");
+    for (int e = 0; e < 300; e++)
+        last = train_epoch(ta, it);
+    check(last.loss < acc_first.loss, "accumulated training keeps reducing the loss");
+
+    batch_iterator_destroy(it);
+    trainer_destroy(ta);
+    trainer_destroy(tb);
+
+    // Test 7: checkpointing recomputes activations without changing the update
+    double wp[7][16], wq[7][16];
+    DenseLayer plain[7], ckpt[7];
+    for (int l = 0; l < 7; l++) {
+        int n_in = l == 0 ? 2 : 4;
+        int n_out = l == 6 ? 2 : 4;
+        for (int i = 0; i < n_in * n_out; i++)
+            wp[l][i] = wq[l][i] = sin(0.7 * i + l) * 0.9;
+        ActivationType act = l == 6 ? ACTIVATION_SOFTMAX : (l % 2 ? ACTIVATION_SIGMOID : ACTIVATION_RELU);
+        plain[l] = (DenseLayer){wp[l], n_in, n_out, act};
+        ckpt[l] = (DenseLayer){wq[l], n_in, n_out, act};
+    }
+
+    Trainer *tp = trainer_create(plain, 7, LOSS_CROSS_ENTROPY, 12, 0.3);
+    Trainer *tc = trainer_create(ckpt, 7, LOSS_CROSS_ENTROPY, 12, 0.3);
+    check(trainer_set_checkpointing(tc, 3) == 0, "trainer_set_checkpointing succeeds");
+    check(tc->plan->total_bytes < tp->plan->total_bytes, "checkpointed trainer arena is smaller");
+
+    double lp = 0.0, lc = 0.0;
+    for (int s = 0; s < 5; s++) {
+        lp = train_step(tp, cx + 2 * s, cy + 2 * s, 12);
+        lc = train_step(tc, cx + 2 * s, cy + 2 * s, 12);
+    }
+    same = lp == lc;
+    for (int l = 0; l < 7; l++)
+        for (int i = 0; i < plain[l].n_in * plain[l].n_out; i++)
+            if (wp[l][i] != wq[l][i]) same = 0;
+    check(same, "checkpointed steps match the plain trainer exactly");
+    check(trainer_set_checkpointing(tc, 0) == -1, "checkpoint interval below 1 rejected");
+
+    trainer_destroy(tp);
+    trainer_destroy(tc);
+
+    free(w1); free(w2);
+    free(x); free(y); free(cx); free(cy);
+
+    printf("\n=== Results ===\n");
+    printf("Passed: %d\n", test_passed);
+    printf("Failed: %d\n", test_failed);
+
+    return test_failed > 0 ? 1 : 0;
+}